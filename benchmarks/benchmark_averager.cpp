@@ -0,0 +1,28 @@
+#include <benchmark/benchmark.h>
+#include <radio/averager.h>
+
+#include <random>
+#include <vector>
+
+static void BM_AveragerPush(benchmark::State& state) {
+  const auto size = static_cast<int>(state.range(0));
+  constexpr auto GROUP_SIZE = 21;
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<float> distribution(-20.0f, 20.0f);
+  std::vector<std::vector<float>> frames(GROUP_SIZE + 1, std::vector<float>(size));
+  for (auto& frame : frames) {
+    for (auto& value : frame) {
+      value = distribution(generator);
+    }
+  }
+
+  Averager averager(size, GROUP_SIZE);
+  size_t index = 0;
+  for (auto _ : state) {
+    averager.push(frames[index].data());
+    benchmark::DoNotOptimize(averager.average().data());
+    index = (index + 1) % frames.size();
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_AveragerPush)->RangeMultiplier(8)->Range(1 << 11, 1 << 17);
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include <radio/averager.h>
+#include <utils/dsp_utils.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+constexpr auto GROUPING = 21;
+constexpr auto START_LEVEL = 8.0f;
+constexpr auto GUARD = 40;
+constexpr auto REFERENCE = 160;
+
+std::vector<std::vector<float>> generateFrames(const int size) {
+  std::mt19937 generator(1234);
+  std::normal_distribution<float> distribution(0.0f, 2.0f);
+  std::vector<std::vector<float>> frames(GROUPING + 1, std::vector<float>(size));
+  for (auto& frame : frames) {
+    for (auto& value : frame) {
+      value = distribution(generator);
+    }
+  }
+  return frames;
+}
+}  // namespace
+
+// cost of one detection frame before signals are tracked, smoothing and threshold scan
+static void BM_DetectionLevel(benchmark::State& state) {
+  const auto size = static_cast<int>(state.range(0));
+  const auto frames = generateFrames(size);
+  const std::vector<uint8_t> mask(size, 1);
+  std::vector<int> indexes(size);
+  Averager averager(size, GROUPING, GROUPING);
+  size_t index = 0;
+  for (auto _ : state) {
+    averager.push(frames[index].data());
+    benchmark::DoNotOptimize(selectIndexes(averager.average().data(), mask.data(), START_LEVEL, size, indexes.data()));
+    index = (index + 1) % frames.size();
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_DetectionLevel)->RangeMultiplier(8)->Range(1 << 11, 1 << 17);
+
+static void BM_DetectionCfar(benchmark::State& state) {
+  const auto size = static_cast<int>(state.range(0));
+  const auto frames = generateFrames(size);
+  const std::vector<uint8_t> mask(size, 1);
+  std::vector<int> indexes(size);
+  std::vector<double> prefix(size + 1);
+  std::vector<float> output(size);
+  Averager averager(size, GROUPING, GROUPING);
+  size_t index = 0;
+  for (auto _ : state) {
+    averager.push(frames[index].data());
+    cfar(averager.average().data(), prefix.data(), output.data(), size, GUARD, REFERENCE);
+    benchmark::DoNotOptimize(selectIndexes(output.data(), mask.data(), START_LEVEL, size, indexes.data()));
+    index = (index + 1) % frames.size();
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_DetectionCfar)->RangeMultiplier(8)->Range(1 << 11, 1 << 17);
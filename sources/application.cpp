@@ -1,6 +1,7 @@
 #include "application.h"
 
 #include <logger.h>
+#include <radio/fftw_wisdom.h>
 #include <utils/file_utils.h>
 
 constexpr auto LABEL = "application";
@@ -18,6 +19,7 @@ Application::Application(nlohmann::json& tmpJson, const ArgConfig& argConfig)
   Logger::info(LABEL, "{}", colored(GREEN, "{}", "started"));
   Logger::info(LABEL, "config: {}", colored(GREEN, "{}", FileConfig::toPrint(m_fileJson).dump()));
   Logger::info(LABEL, "mqtt: {}", colored(GREEN, "{}", m_config.mqtt()));
+  importFftwWisdom(m_config);
 
   for (const auto& device : m_config.devices()) {
     try {
@@ -72,6 +74,10 @@ Application::Application(nlohmann::json& tmpJson, const ArgConfig& argConfig)
   });
 }
 
-Application::~Application() { Logger::info(LABEL, "{}", colored(GREEN, "{}", "stopped")); }
+Application::~Application() {
+  // keeps plans of gnuradio fft blocks created since start
+  exportFftwWisdom(m_config);
+  Logger::info(LABEL, "{}", colored(GREEN, "{}", "stopped"));
+}
 
 bool Application::reload() const { return m_reload; }
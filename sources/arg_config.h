@@ -15,4 +15,9 @@ struct ArgConfig {
   bool enumerateRemote = false;
   bool dumpSource = false;
   bool dumpRecording = false;
+  std::string replayDir;
+  bool replayThrottle = true;
+  bool stagedDetection = false;
+  bool fftExhaustive = false;
+  bool sharedRingExport = false;
 };
\ No newline at end of file
@@ -64,3 +64,8 @@ std::string Config::workDir() const { return m_argConfig.workDir; }
 
 bool Config::dumpSource() const { return m_argConfig.dumpSource; }
 bool Config::dumpRecording() const { return m_argConfig.dumpRecording; }
+std::string Config::replayDir() const { return m_argConfig.replayDir; }
+bool Config::replayThrottle() const { return m_argConfig.replayThrottle; }
+bool Config::stagedDetection() const { return m_argConfig.stagedDetection; }
+bool Config::fftExhaustive() const { return m_argConfig.fftExhaustive; }
+bool Config::sharedRingExport() const { return m_argConfig.sharedRingExport; }
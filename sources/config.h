@@ -10,22 +10,41 @@
 #include <string>
 
 // INTERNAL SETTINGS
-constexpr auto INITIAL_DELAY = std::chrono::milliseconds(1000);           // delay after first start sdr device to start processing
-constexpr auto PERFORMANCE_LOGGER_INTERVAL = 1000;                        // print stats every n frames
-constexpr auto RECORDER_FLUSH_INTERVAL = std::chrono::milliseconds(100);  // flush recordings to mqtt every 2 * n bytes
-constexpr auto TRANSMISSION_MAX_TIME = std::chrono::minutes(10);          // break transmission if longer that
+constexpr auto INITIAL_DELAY = std::chrono::milliseconds(1000);             // delay after first start sdr device to start processing
+constexpr auto PERFORMANCE_LOGGER_INTERVAL = 1000;                          // print stats every n frames
+constexpr auto RECORDER_FLUSH_INTERVAL = std::chrono::milliseconds(100);    // flush recordings to mqtt every 2 * n bytes
+constexpr auto TRANSMISSION_MAX_TIME = std::chrono::minutes(10);            // break transmission if longer that
+constexpr auto SOURCE_READER_BUFFER_TIME = std::chrono::milliseconds(500);  // source reader thread ring buffer size
+constexpr auto SOURCE_MAX_TIME_DRIFT = std::chrono::milliseconds(50);       // anchor sample counter to system clock again if drift is bigger
+constexpr auto RECORDER_RING_BUFFER_TIME = std::chrono::milliseconds(100);  // recorder falling behind stream more than n loses samples
+constexpr auto RECORDER_HISTORY_TIME = std::chrono::milliseconds(25);       // samples kept while no recorder runs, recorder starts from them, has to fit into quarter of ring
+constexpr auto SHARED_RING_BUFFER_TIME = std::chrono::milliseconds(500);    // raw IQ kept in shared memory ring for external processes
 
 // SCANNING SETTINGS
-constexpr auto NOISE_LEARNING_TIME = std::chrono::milliseconds(2000);  // noise learnig time
-constexpr auto RANGE_SCANNING_TIME = std::chrono::milliseconds(500);   // waiting time for transmission in single scanning range
+constexpr auto NOISE_LEARNING_TIME = std::chrono::milliseconds(2000);         // noise learnig time
+constexpr auto RANGE_SCANNING_TIME = std::chrono::milliseconds(500);          // waiting time for transmission in single scanning range
+constexpr auto RETUNE_SETTLE_DEFAULT_TIME = std::chrono::microseconds(1000);  // samples dropped after retune until first measurement
+constexpr auto RETUNE_SETTLE_MEASURE_TIME = std::chrono::milliseconds(20);    // power measured after every retune to find settle time
+constexpr auto RETUNE_SETTLE_BLOCK_SIZE = 256;                                // samples in single power measurement
+constexpr auto RETUNE_SETTLE_TOLERANCE = 3.0f;                                // power differences in dB treated as settled
+constexpr auto RETUNE_SETTLE_MEASUREMENTS = 15;                               // settle time is median of last n measurements
 
 // SIGNAL DETECTION SETTINGS
-constexpr auto GROUPING_X = 21;                    // average n frames in frequency domain
-constexpr auto GROUPING_Y = 21;                    // average n frames in time domain
+constexpr auto DEFAULT_GROUPING_X = 21;            // average n frames in frequency domain
+constexpr auto DEFAULT_GROUPING_Y = 21;            // average n frames in time domain
 constexpr auto DEFAULT_RECORDING_START_LEVEL = 8;  // start recording if average power greather than n
 constexpr auto DEFAULT_RECORDING_STOP_LEVEL = 5;   // stop recording if average power lower than n
 constexpr auto SIGNAL_DETECTION_FPS = 50;          // reduce cpu usage
+constexpr auto CFAR_DETECTION_MODE = "cfar";       // detection relative to neighbour bins instead of learned noise
+constexpr auto CFAR_REFERENCE_GROUPS = 4;          // default reference window in signal widths
+constexpr auto ZOOM_COARSE_MAX_STEP = 4000;        // max step of coarse fft in zoom detection
+constexpr auto ZOOM_SPAN_COARSE_BINS = 4;          // zoom fft covers n coarse bins around requested index
+constexpr auto ZOOM_COARSE_SEGMENTS = 2;           // coarse spectrum is average of n segments spread over frame
 constexpr auto SIGNAL_DETECTION_MAX_STEP = 250;    // max step after fft
+constexpr auto FFT_THREAD_MIN_SIZE = 65536;        // detection fft gets one more thread per n bins
+constexpr auto FFT_MAX_THREADS = 4;                // limit of detection fft threads, half of cores is left for recorders
+constexpr auto FFT_BATCH_SAMPLES = 65536;          // queued frames are transformed in batches of up to n samples
+constexpr auto FFT_MAX_BATCH = 16;                 // limit of frames in single batch
 
 // SPECTROGRAM SETTINGS
 constexpr auto SPECTROGRAM_PREFERRED_MAX_STEP = 1000;                        // spectrogram preferred max step
@@ -34,6 +53,10 @@ constexpr auto SPECTROGRAM_SEND_INTERVAL = std::chrono::milliseconds(1000);  //
 
 // RECORDER SETTINGS
 constexpr auto RECORDER_SAMPLE_RATE_DECIMATOR = 2000000;
+constexpr auto RECORDER_CHANNEL_SPACING = 200000;  // device band is split once into channels n Hz apart, recorders take nearest channel
+constexpr auto RECORDER_CHANNEL_MIN_COUNT = 4;     // narrower bands are not split, recorders filter full rate stream
+constexpr auto RECORDER_POOL_SIZE = 2;             // idle recorders kept prepared for next transmissions
+constexpr auto RECORDER_THREADS = 2;               // threads shared by all recordings of device, recorder filters only its channel
 
 // SOURCE AND RECORDING NAMES
 constexpr auto GAIN_TESTER_SOURCE_NAME = "gain tester";
@@ -71,6 +94,11 @@ class Config {
   std::string workDir() const;
   bool dumpSource() const;
   bool dumpRecording() const;
+  std::string replayDir() const;
+  bool replayThrottle() const;
+  bool stagedDetection() const;
+  bool fftExhaustive() const;
+  bool sharedRingExport() const;
 
  private:
   const std::string m_id;
@@ -30,15 +30,22 @@ class Logger {
   static void configure(
       const spdlog::level::level_enum logLevelConsole, const spdlog::level::level_enum logLevelFile, const std::string& logFile, int fileSize, int filesCount, bool isColorLogEnabled);
   static bool isColorLogEnabled();
+  static bool isEnabled(const spdlog::level::level_enum level) { return spdlog::default_logger_raw()->should_log(level); }
 
   template <typename... Args>
   static void trace(const char* label, fmt::format_string<Args...> fmt, Args&&... args) {
+    if (!isEnabled(spdlog::level::trace)) {
+      return;
+    }
     auto msg = fmt::format(fmt, std::forward<Args>(args)...);
     spdlog::trace("[{:12}] {}", label, msg);
   }
 
   template <typename... Args>
   static void debug(const char* label, fmt::format_string<Args...> fmt, Args&&... args) {
+    if (!isEnabled(spdlog::level::debug)) {
+      return;
+    }
     auto msg = fmt::format(fmt, std::forward<Args>(args)...);
     spdlog::debug("[{:12}] {}", label, msg);
   }
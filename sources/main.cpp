@@ -33,6 +33,11 @@ int main(int argc, char** argv) {
   app.add_option("--remote", argConfig.enumerateRemote, "enable remote device enumeration");
   app.add_option("--dump-source", argConfig.dumpSource, "dump source raw IQ");
   app.add_option("--dump-recording", argConfig.dumpRecording, "dump recording raw IQ");
+  app.add_option("--replay-dir", argConfig.replayDir, "replay raw IQ dumped by --dump-source instead of reading devices");
+  app.add_option("--replay-throttle", argConfig.replayThrottle, "replay raw IQ with recorded sample rate, otherwise as fast as possible");
+  app.add_option("--staged-detection", argConfig.stagedDetection, "run psd, noise learner and transmission as separate blocks instead of one fused block");
+  app.add_option("--fft-exhaustive", argConfig.fftExhaustive, "plan ffts missing in wisdom file exhaustively, slow first start but faster ffts");
+  app.add_option("--shm-export", argConfig.sharedRingExport, "export raw IQ of every device to shared memory ring in /dev/shm for external processes");
   CLI11_PARSE(app, argc, argv);
 
   dup2(fileno(fopen("/dev/null", "w")), fileno(stderr));
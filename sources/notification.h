@@ -2,7 +2,6 @@
 
 #include <condition_variable>
 #include <mutex>
-#include <optional>
 
 template <typename T>
 class Notification {
@@ -11,22 +10,24 @@ class Notification {
   Notification(const Notification&) = delete;
   Notification& operator=(const Notification&) = delete;
 
+  // value is copied into kept storage, notifier does not allocate when storage is big enough
   void notify(const T& value) {
     std::unique_lock<std::mutex> lock(m_mutex);
     m_value = value;
+    m_isReady = true;
     m_cv.notify_all();
   }
 
   T wait() {
     std::unique_lock<std::mutex> lock(m_mutex);
-    m_cv.wait(lock, [this]() { return m_value.has_value(); });
-    T value = std::move(m_value.value());
-    m_value = std::nullopt;
-    return value;
+    m_cv.wait(lock, [this]() { return m_isReady; });
+    m_isReady = false;
+    return m_value;
   }
 
  private:
   std::mutex m_mutex;
   std::condition_variable m_cv;
-  std::optional<T> m_value;
+  T m_value{};
+  bool m_isReady{false};
 };
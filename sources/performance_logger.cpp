@@ -4,7 +4,8 @@
 #include <logger.h>
 #include <utils/utils.h>
 
-PerformanceLogger::PerformanceLogger(const std::string& label, const std::string& name) : m_label(label), m_name(name), m_samplesCount(0), m_lastLog(getTime()) {}
+PerformanceLogger::PerformanceLogger(const std::string& label, const std::string& name, const int frameSize)
+    : m_label(label), m_name(name), m_frameSize(frameSize), m_samplesCount(0), m_lastLog(getTime()) {}
 
 void PerformanceLogger::kick() {
   m_samplesCount++;
@@ -12,10 +13,13 @@ void PerformanceLogger::kick() {
     const auto now = getTime();
     const auto speed = (now - m_lastLog).count() / static_cast<float>(PERFORMANCE_LOGGER_INTERVAL);
     const auto fps = static_cast<float>(PERFORMANCE_LOGGER_INTERVAL * 1000) / (now - m_lastLog).count();
-    if (!m_name.empty()) {
-      Logger::debug(m_label.c_str(), "{}, average frame time: {:.4f} ms, fps: {:.4f}", m_name, speed, fps);
+    const auto prefix = m_name.empty() ? std::string() : m_name + ", ";
+    if (0 < m_frameSize) {
+      // throughput in input samples, frames are transformed from complex samples
+      const auto throughput = fps * static_cast<float>(m_frameSize) / 1e6f;
+      Logger::debug(m_label.c_str(), "{}average frame time: {:.4f} ms, fps: {:.4f}, throughput: {:.2f} MS/s", prefix, speed, fps, throughput);
     } else {
-      Logger::debug(m_label.c_str(), "average frame time: {:.4f} ms, fps: {:.4f}", speed, fps);
+      Logger::debug(m_label.c_str(), "{}average frame time: {:.4f} ms, fps: {:.4f}", prefix, speed, fps);
     }
     m_lastLog = now;
   }
@@ -5,12 +5,13 @@
 
 class PerformanceLogger {
  public:
-  PerformanceLogger(const std::string& label, const std::string& name = "");
+  PerformanceLogger(const std::string& label, const std::string& name = "", const int frameSize = 0);
   void kick();
 
  private:
   const std::string m_label;
   const std::string m_name;
+  const int m_frameSize;
   uint64_t m_samplesCount;
   std::chrono::milliseconds m_lastLog;
 };
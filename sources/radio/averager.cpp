@@ -1,61 +1,61 @@
 #include "averager.h"
 
+#include <utils/dsp_utils.h>
 #include <utils/utils.h>
 
-#include <cstring>
-
-Averager::Averager(int size, int groupSize) : m_size(size), m_groupSize(groupSize), m_sum(size, 0.0), m_average(size, 0.0), m_frames(0) {
-  for (int i = 0; i < m_groupSize; ++i) {
-    m_buffers.emplace_back(m_size, 0.0);
-  }
-  updateAverage();
+#include <algorithm>
+
+Averager::Averager(int size, int groupSize, int frequencyGroupSize)
+    : m_size(size),
+      m_groupSize(groupSize),
+      m_frequencyGroupSize(frequencyGroupSize),
+      m_sum(size, 0.0),
+      m_prefix(size + 1, 0.0),
+      m_average(size, 0.0),
+      m_history(static_cast<size_t>(size) * groupSize, 0.0),
+      m_head(0),
+      m_frames(0) {
+  setNoData(m_average.data(), m_size);
 }
 
 void Averager::push(const float* data) {
   m_frames = std::min(m_frames + 1, m_groupSize);
-  Buffer buffer = std::move(m_buffers.front());
-  subtract(buffer.data());
-  m_buffers.pop_front();
+  float* oldest = m_history.data() + static_cast<size_t>(m_head) * m_size;
+  m_head = (m_head + 1) % m_groupSize;
+
+  // oldest frame is replaced by new one and time sum is updated in the same pass
+  float* sum = m_sum.data();
+  for (int i = 0; i < m_size; ++i) {
+    sum[i] += data[i] - oldest[i];
+    oldest[i] = data[i];
+  }
+  if (m_groupSize <= m_frames) {
+    // time and frequency averages are one separable box filter, time sum is divided together with frequency window
+    boxFilter(m_sum.data(), m_prefix.data(), m_average.data(), m_size, m_frequencyGroupSize, m_groupSize);
+  }
+}
 
-  std::memcpy(buffer.data(), data, sizeof(float) * m_size);
-  add(buffer.data());
-  m_buffers.push_back(std::move(buffer));
+void Averager::push(const std::complex<float>* input, const float* noise, float* power, const float offset) {
+  m_frames = std::min(m_frames + 1, m_groupSize);
+  float* oldest = m_history.data() + static_cast<size_t>(m_head) * m_size;
+  m_head = (m_head + 1) % m_groupSize;
 
-  updateAverage();
+  powerToHistory(input, noise, power, oldest, m_sum.data(), m_size, offset);
+  if (m_groupSize <= m_frames) {
+    boxFilter(m_sum.data(), m_prefix.data(), m_average.data(), m_size, m_frequencyGroupSize, m_groupSize);
+  }
 }
 
 void Averager::reset() {
   std::fill(m_sum.begin(), m_sum.end(), 0);
-  for (auto& buffer : m_buffers) {
-    std::fill(buffer.begin(), buffer.end(), 0);
-  }
+  std::fill(m_history.begin(), m_history.end(), 0);
+  m_head = 0;
   m_frames = 0;
-  updateAverage();
+  setNoData(m_average.data(), m_size);
 }
 
 const std::vector<float>& Averager::average() const { return m_average; }
 
-const std::deque<Averager::Buffer>& Averager::data() const { return m_buffers; }
+int Averager::rows() const { return m_groupSize; }
 
-void Averager::add(const float* data) {
-  for (int i = 0; i < m_size; ++i) {
-    m_sum[i] += data[i];
-  }
-}
-
-void Averager::subtract(const float* data) {
-  for (int i = 0; i < m_size; ++i) {
-    m_sum[i] -= data[i];
-  }
-}
-
-void Averager::updateAverage() {
-  const auto isReady = m_groupSize <= m_frames;
-  if (isReady) {
-    for (int i = 0; i < m_size; ++i) {
-      m_average[i] = m_sum[i] / m_groupSize;
-    }
-  } else {
-    setNoData(m_average.data(), m_size);
-  }
-}
\ No newline at end of file
+const float* Averager::row(const int index) const { return m_history.data() + static_cast<size_t>((m_head + index) % m_groupSize) * m_size; }
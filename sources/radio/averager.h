@@ -2,28 +2,30 @@
 
 #include <radio/help_structures.h>
 
-#include <deque>
+#include <complex>
 #include <vector>
 
+// running average of last n frames smoothed also in frequency domain, history is one contiguous ring of n frames
 class Averager {
-  using Buffer = std::vector<float>;
-
  public:
-  Averager(int size, int groupSize);
+  Averager(int size, int groupSize, int frequencyGroupSize = 1);
   void push(const float* data);
+  // frame is power of input minus noise, it is computed directly into history, power is written to output too
+  void push(const std::complex<float>* input, const float* noise, float* power, const float offset);
   void reset();
   const std::vector<float>& average() const;
-  const std::deque<Buffer>& data() const;
+  // history from the oldest frame to the newest one
+  int rows() const;
+  const float* row(const int index) const;
 
  private:
-  void add(const float* data);
-  void subtract(const float* data);
-  void updateAverage();
-
   const int m_size;
   const int m_groupSize;
+  const int m_frequencyGroupSize;
   std::vector<float> m_sum;
+  std::vector<double> m_prefix;
   std::vector<float> m_average;
-  std::deque<Buffer> m_buffers;
+  std::vector<float> m_history;
+  int m_head;
   int m_frames;
-};
\ No newline at end of file
+};
@@ -0,0 +1,108 @@
+#include "batch_fft.h"
+
+#include <gnuradio/fft/fft.h>
+#include <gnuradio/fft/window.h>
+#include <logger.h>
+#include <radio/fftw_wisdom.h>
+
+#include <algorithm>
+
+constexpr auto LABEL = "fft";
+
+namespace {
+fftwf_plan makePlan(const int size, const int count, fftwf_complex* in, fftwf_complex* out, const unsigned flags) {
+  const int n[] = {size};
+  return fftwf_plan_many_dft(1, n, count, in, nullptr, 1, size, out, nullptr, 1, size, FFTW_FORWARD, flags);
+}
+}  // namespace
+
+BatchFft::BatchFft(const Config& config, const int size, const int batch, const int threads)
+    : gr::sync_block("BatchFft", gr::io_signature::make(1, 1, sizeof(gr_complex) * size), gr::io_signature::make(1, 1, sizeof(gr_complex) * size)),
+      m_performanceLogger(LABEL, "", size),
+      m_size(size),
+      m_batch(batch),
+      m_threads(threads),
+      m_window(gr::fft::window::hamming(size)),
+      m_in(fftwf_alloc_complex(static_cast<size_t>(size) * batch)),
+      m_out(fftwf_alloc_complex(static_cast<size_t>(size) * batch)) {
+  // fft shift is done by modulating input with (-1)^n, output is written directly without reordering, size is always even
+  for (int i = 1; i < m_size; i += 2) {
+    m_window[i] = -m_window[i];
+  }
+
+  // exhaustive wisdom satisfies measure requests too, so exhaustive planning is paid only once per cpu and size
+  const auto flags = config.fftExhaustive() ? FFTW_EXHAUSTIVE : FFTW_MEASURE;
+  bool isPlanned = false;
+  {
+    // fftw planner is not thread safe, gnuradio fft blocks use the same lock
+    gr::fft::planner::scoped_lock lock(gr::fft::planner::mutex());
+    static bool threadsInitialized = false;
+    if (!threadsInitialized) {
+      fftwf_init_threads();
+      threadsInitialized = true;
+    }
+    fftwf_plan_with_nthreads(m_threads);
+    const auto plan = [this, flags, &isPlanned](const int count) {
+      const auto plan = makePlan(m_size, count, m_in, m_out, flags | FFTW_WISDOM_ONLY);
+      if (plan) {
+        return plan;
+      }
+      Logger::info(LABEL, "planning, size: {}, count: {}, exhaustive: {}", colored(GREEN, "{}", m_size), colored(GREEN, "{}", count), colored(GREEN, "{}", flags == FFTW_EXHAUSTIVE));
+      isPlanned = true;
+      return makePlan(m_size, count, m_in, m_out, flags);
+    };
+    m_batchPlan = plan(m_batch);
+    m_framePlan = plan(1);
+    fftwf_plan_with_nthreads(1);
+  }
+  if (isPlanned) {
+    exportFftwWisdom(config);
+  }
+  Logger::info(LABEL, "size: {}, batch: {}, threads: {}", colored(GREEN, "{}", m_size), colored(GREEN, "{}", m_batch), colored(GREEN, "{}", m_threads));
+}
+
+BatchFft::~BatchFft() {
+  gr::fft::planner::scoped_lock lock(gr::fft::planner::mutex());
+  fftwf_destroy_plan(m_batchPlan);
+  fftwf_destroy_plan(m_framePlan);
+  fftwf_free(m_in);
+  fftwf_free(m_out);
+}
+
+int BatchFft::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
+  const gr_complex* input_buf = static_cast<const gr_complex*>(input_items[0]);
+  gr_complex* output_buf = static_cast<gr_complex*>(output_items[0]);
+
+  int i = 0;
+  for (; i + m_batch <= noutput_items; i += m_batch) {
+    execute(m_batchPlan, &input_buf[static_cast<size_t>(i) * m_size], &output_buf[static_cast<size_t>(i) * m_size], m_batch);
+  }
+  for (; i < noutput_items; ++i) {
+    execute(m_framePlan, &input_buf[static_cast<size_t>(i) * m_size], &output_buf[static_cast<size_t>(i) * m_size], 1);
+  }
+
+  return noutput_items;
+}
+
+void BatchFft::execute(const fftwf_plan plan, const gr_complex* input, gr_complex* output, const int count) {
+  gr_complex* in = reinterpret_cast<gr_complex*>(m_in);
+  for (int frame = 0; frame < count; ++frame) {
+    const auto offset = static_cast<size_t>(frame) * m_size;
+    for (int i = 0; i < m_size; ++i) {
+      in[offset + i] = input[offset + i] * m_window[i];
+    }
+  }
+
+  // plan can write to any buffer with the same alignment as planned one, otherwise output is copied
+  fftwf_complex* out = reinterpret_cast<fftwf_complex*>(output);
+  if (fftwf_alignment_of(reinterpret_cast<float*>(out)) == fftwf_alignment_of(reinterpret_cast<float*>(m_out))) {
+    fftwf_execute_dft(plan, m_in, out);
+  } else {
+    fftwf_execute_dft(plan, m_in, m_out);
+    const gr_complex* result = reinterpret_cast<const gr_complex*>(m_out);
+    std::copy(result, result + static_cast<size_t>(count) * m_size, output);
+  }
+  for (int frame = 0; frame < count; ++frame) {
+    m_performanceLogger.kick();
+  }
+}
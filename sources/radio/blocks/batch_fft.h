@@ -0,0 +1,32 @@
+#pragma once
+
+#include <config.h>
+#include <fftw3.h>
+#include <gnuradio/sync_block.h>
+#include <performance_logger.h>
+
+#include <vector>
+
+// windowed and shifted forward fft of detection frames, same output as fft_v with shift
+// queued frames are transformed by one batched fftw plan, long transforms are split between threads
+// plans are taken from wisdom when possible, new plans are saved to wisdom file
+class BatchFft : virtual public gr::sync_block {
+ public:
+  BatchFft(const Config& config, const int size, const int batch, const int threads);
+  ~BatchFft() override;
+
+  int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+ private:
+  void execute(const fftwf_plan plan, const gr_complex* input, gr_complex* output, const int count);
+
+  PerformanceLogger m_performanceLogger;
+  const int m_size;
+  const int m_batch;
+  const int m_threads;
+  std::vector<float> m_window;
+  fftwf_complex* m_in;
+  fftwf_complex* m_out;
+  fftwf_plan m_batchPlan;
+  fftwf_plan m_framePlan;
+};
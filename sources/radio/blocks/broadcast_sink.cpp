@@ -0,0 +1,22 @@
+#include "broadcast_sink.h"
+
+BroadcastSink::BroadcastSink(const std::vector<Broadcast>& broadcasts, const double itemRate, std::function<void()> notify)
+    : gr::sync_block("BroadcastSink", gr::io_signature::make(broadcasts.size(), broadcasts.size(), sizeof(gr_complex)), gr::io_signature::make(0, 0, 0)),
+      m_broadcasts(broadcasts),
+      m_timeTags(broadcasts.size(), TimeTagReader(itemRate)),
+      m_notify(notify) {}
+
+int BroadcastSink::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star&) {
+  bool hasReaders = false;
+  for (size_t i = 0; i < m_broadcasts.size(); ++i) {
+    const auto& broadcast = m_broadcasts[i];
+    get_tags_in_window(m_timeTags[i].tags(), i, 0, noutput_items, TIME_TAG);
+    broadcast.timeAnchor->set(broadcast.ring->written(), m_timeTags[i].getExactTime(nitems_read(i)));
+    broadcast.ring->write(static_cast<const gr_complex*>(input_items[i]), noutput_items);
+    hasReaders |= broadcast.ring->hasReaders();
+  }
+  if (hasReaders) {
+    m_notify();
+  }
+  return noutput_items;
+}
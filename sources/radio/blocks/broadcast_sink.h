@@ -0,0 +1,32 @@
+#pragma once
+
+#include <gnuradio/sync_block.h>
+#include <radio/stream_tags.h>
+#include <utils/broadcast_ring.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+// full rate stream or one channel of channelizer shared with recorders
+struct Broadcast {
+  std::shared_ptr<BroadcastRing<gr_complex>> ring;
+  std::shared_ptr<TimeAnchor> timeAnchor;
+};
+
+// writes every input once to its in-process ring shared by all readers
+// rings are written also without readers, so new reader can start from samples written before it
+// all channels are written by single block so their count does not add threads
+// time tags are not stored in ring, time of written samples is kept in shared anchor
+// readers are notified after every write when any ring has readers
+class BroadcastSink : virtual public gr::sync_block {
+ public:
+  BroadcastSink(const std::vector<Broadcast>& broadcasts, const double itemRate, std::function<void()> notify);
+
+  int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+ private:
+  const std::vector<Broadcast> m_broadcasts;
+  std::vector<TimeTagReader> m_timeTags;
+  const std::function<void()> m_notify;
+};
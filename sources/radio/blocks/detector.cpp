@@ -0,0 +1,43 @@
+#include "detector.h"
+
+#include <utils/dsp_utils.h>
+
+#include <cmath>
+
+constexpr auto LABEL = "detector";
+
+Detector::Detector(const int itemSize, const Frequency sampleRate, const double itemRate, std::shared_ptr<NoiseLearner> noiseLearner, std::shared_ptr<Transmission> transmission)
+    : gr::sync_block("Detector", gr::io_signature::make(1, 1, sizeof(gr_complex) * itemSize), gr::io_signature::make(1, 1, sizeof(float) * itemSize)),
+      m_performanceLogger(LABEL),
+      m_itemSize(itemSize),
+      m_powerOffset(-10.0f * std::log10(static_cast<float>(sampleRate))),
+      m_noiseLearner(noiseLearner),
+      m_transmission(transmission),
+      m_timeTags(itemRate),
+      m_noiseFree(itemSize) {}
+
+int Detector::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
+  const gr_complex* input_buf = static_cast<const gr_complex*>(input_items[0]);
+  float* output_buf = static_cast<float*>(output_items[0]);
+
+  get_tags_in_window(m_timeTags.tags(), 0, 0, noutput_items, TIME_TAG);
+  get_tags_in_window(m_rangeTags.tags(), 0, 0, noutput_items, RANGE_TAG);
+  for (int i = 0; i < noutput_items; ++i) {
+    m_performanceLogger.kick();
+    const auto fitIndex = i * m_itemSize;
+    const auto range = m_rangeTags.getRange(nitems_read(0) + i);
+    const auto time = m_timeTags.getTime(nitems_read(0) + i);
+    const auto noise = 0 <= range ? m_noiseLearner->getNoise(range) : nullptr;
+    if (noise) {
+      // power, noise subtraction and averager history are computed in one pass over frame
+      m_transmission->process(range, &input_buf[fitIndex], noise, &output_buf[fitIndex], m_powerOffset, time);
+    } else {
+      // noise is learned or frame is out of scanned ranges
+      powerToDb(&input_buf[fitIndex], &output_buf[fitIndex], m_itemSize, m_powerOffset);
+      m_noiseLearner->process(range, &output_buf[fitIndex], m_noiseFree.data());
+      m_transmission->process(range, m_noiseFree.data(), time);
+    }
+  }
+
+  return noutput_items;
+}
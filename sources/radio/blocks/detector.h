@@ -0,0 +1,30 @@
+#pragma once
+
+#include <gnuradio/sync_block.h>
+#include <performance_logger.h>
+#include <radio/blocks/noise_learner.h>
+#include <radio/blocks/transmission.h>
+#include <radio/help_structures.h>
+#include <radio/stream_tags.h>
+
+#include <memory>
+#include <vector>
+
+// fused psd, noise learner and transmission, power, noise subtraction and averager update are one pass over frame
+// only frequency smoothing and detection read the frame again, while noise is learned stages run separately
+class Detector : virtual public gr::sync_block {
+ public:
+  Detector(const int itemSize, const Frequency sampleRate, const double itemRate, std::shared_ptr<NoiseLearner> noiseLearner, std::shared_ptr<Transmission> transmission);
+
+  int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+ private:
+  PerformanceLogger m_performanceLogger;
+  const int m_itemSize;
+  const float m_powerOffset;
+  const std::shared_ptr<NoiseLearner> m_noiseLearner;
+  const std::shared_ptr<Transmission> m_transmission;
+  TimeTagReader m_timeTags;
+  RangeTagReader m_rangeTags;
+  std::vector<float> m_noiseFree;
+};
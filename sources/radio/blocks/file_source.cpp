@@ -0,0 +1,141 @@
+#include "file_source.h"
+
+#include <logger.h>
+#include <utils/utils.h>
+
+#include <filesystem>
+#include <regex>
+#include <thread>
+
+constexpr auto LABEL = "file_source";
+constexpr auto THROUGHPUT_LOG_INTERVAL = std::chrono::seconds(10);
+
+namespace {
+std::map<Frequency, std::string> findFiles(const std::string& dir, const Device& device) {
+  // file names are created by getRawFileName, full source dump is not used because it mixes samples of all ranges
+  const std::regex regex(R"(^\d{8}_\d{6}_(\d+)_(\d+)_fc\.raw$)");
+  const auto prefix = fmt::format("{}-{}-source_", device.driver, device.serial);
+  std::map<Frequency, std::string> files;
+  for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+    const auto name = entry.path().filename().string();
+    if (!entry.is_regular_file() || entry.file_size() == 0 || !name.starts_with(prefix)) {
+      continue;
+    }
+    const std::string rest = name.substr(prefix.size());
+    std::smatch match;
+    if (!std::regex_match(rest, match, regex)) {
+      continue;
+    }
+    const auto frequency = static_cast<Frequency>(std::stol(match[1].str()));
+    const auto sampleRate = static_cast<Frequency>(std::stol(match[2].str()));
+    if (sampleRate != device.sample_rate) {
+      Logger::warn(LABEL, "skipping file, invalid sample rate: {}, file: {}", formatFrequency(sampleRate, RED), name);
+      continue;
+    }
+    // newest dump of frequency is used
+    const auto path = entry.path().string();
+    if (files[frequency] < path) {
+      files[frequency] = path;
+    }
+  }
+  return files;
+}
+}  // namespace
+
+FileSource::FileSource(const Config& config, const Device& device)
+    : gr::sync_block("FileSource", gr::io_signature::make(0, 0, 0), gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      Source(device.sample_rate, false),
+      m_configDevice(device),
+      m_throttle(config.replayThrottle()),
+      m_files(findFiles(config.replayDir(), device)),
+      m_file(nullptr),
+      m_samples(0),
+      m_lastLogSamples(0) {
+  Logger::info(LABEL, "replay dir: {}, throttle: {}", colored(GREEN, "{}", config.replayDir()), colored(GREEN, "{}", m_throttle));
+  if (m_files.empty()) {
+    throw std::runtime_error(fmt::format("no replay files found for device: {}", device.getName()));
+  }
+  for (const auto& [frequency, path] : m_files) {
+    Logger::info(LABEL, "replay file, frequency: {}, file: {}", formatFrequency(frequency), colored(GREEN, "{}", path));
+    m_streams[frequency].open(path, std::ios::binary);
+  }
+  m_file = &m_streams.begin()->second;
+}
+
+int FileSource::work(int noutput_items, gr_vector_const_void_star&, gr_vector_void_star& output_items) {
+  gr_complex* out = static_cast<gr_complex*>(output_items[0]);
+
+  int count = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    count = read(out, noutput_items);
+  }
+  if (m_throttle) {
+    throttle(count);
+  }
+  addTags(count);
+  logThroughput(count);
+  return count;
+}
+
+bool FileSource::start() {
+  resetTime();
+  m_startTime = std::chrono::steady_clock::now();
+  m_samples = 0;
+  m_lastLogTime = m_startTime;
+  m_lastLogSamples = 0;
+  return true;
+}
+
+bool FileSource::setCenterFrequency(Frequency frequency) {
+  std::set<Frequency> frequencies;
+  for (const auto& [f, path] : m_files) {
+    frequencies.insert(f);
+  }
+  const auto fileFrequency = getNearestElement(frequencies, frequency);
+  if (fileFrequency != frequency) {
+    Logger::warn(LABEL, "replay file not found, frequency: {}, using: {}", formatFrequency(frequency, RED), formatFrequency(fileFrequency, RED));
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_file = &m_streams.at(fileFrequency);
+  setRetuned(frequency);
+  return m_file->is_open();
+}
+
+int FileSource::read(gr_complex* data, const int count) {
+  int total = 0;
+  bool isRewound = false;
+  while (total < count && m_file->is_open()) {
+    m_file->read(reinterpret_cast<char*>(data + total), sizeof(gr_complex) * (count - total));
+    const auto samples = static_cast<int>(m_file->gcount() / sizeof(gr_complex));
+    total += samples;
+    if (total < count) {
+      if (isRewound && samples == 0) {
+        break;
+      }
+      m_file->clear();
+      m_file->seekg(0);
+      isRewound = true;
+    }
+  }
+  return total;
+}
+
+void FileSource::throttle(const int count) {
+  m_samples += count;
+  const auto time = std::chrono::duration<double>(static_cast<double>(m_samples) / m_configDevice.sample_rate);
+  std::this_thread::sleep_until(m_startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(time));
+}
+
+void FileSource::logThroughput(const int count) {
+  m_lastLogSamples += count;
+  const auto now = std::chrono::steady_clock::now();
+  const auto duration = std::chrono::duration<double>(now - m_lastLogTime);
+  if (THROUGHPUT_LOG_INTERVAL <= duration) {
+    const auto speed = m_lastLogSamples / duration.count();
+    Logger::info(LABEL, "throughput: {}, realtime factor: {:.2f}", colored(GREEN, "{:.2f} MS/s", speed / 1e6), speed / m_configDevice.sample_rate);
+    m_lastLogTime = now;
+    m_lastLogSamples = 0;
+  }
+}
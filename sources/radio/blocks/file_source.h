@@ -0,0 +1,39 @@
+#pragma once
+
+#include <config.h>
+#include <radio/blocks/source.h>
+#include <radio/help_structures.h>
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+
+class FileSource : public Source {
+ public:
+  FileSource(const Config& config, const Device& device);
+
+  int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+  bool start() override;
+
+  bool setCenterFrequency(Frequency frequency) override;
+
+ private:
+  int read(gr_complex* data, const int count);
+  void throttle(const int count);
+  void logThroughput(const int count);
+
+  const Device m_configDevice;
+  const bool m_throttle;
+  std::map<Frequency, std::string> m_files;
+  // every file is read from position where previous dwell on its frequency ended
+  std::map<Frequency, std::ifstream> m_streams;
+  std::mutex m_mutex;
+  std::ifstream* m_file;
+  std::chrono::steady_clock::time_point m_startTime;
+  uint64_t m_samples;
+  std::chrono::steady_clock::time_point m_lastLogTime;
+  uint64_t m_lastLogSamples;
+};
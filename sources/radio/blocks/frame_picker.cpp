@@ -0,0 +1,121 @@
+#include "frame_picker.h"
+
+#include <logger.h>
+#include <utils/radio_utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+constexpr auto LABEL = "frame picker";
+
+FramePicker::FramePicker(const int frameSize, const int frameStep, const Frequency sampleRate, const std::vector<FrequencyRange>& ranges, SettleEstimator& settleEstimator)
+    : gr::block("FramePicker", gr::io_signature::make(1, 1, sizeof(gr_complex)), gr::io_signature::make(1, 1, sizeof(gr_complex) * frameSize)),
+      m_frameSize(frameSize),
+      m_frameStep(frameStep),
+      m_ranges(ranges),
+      m_settleEstimator(settleEstimator),
+      m_timeTags(sampleRate),
+      m_range(-1),
+      m_isRangeTagPending(false),
+      m_frameOffset(0),
+      m_isMeasuring(false),
+      m_measureOffset(0),
+      m_blockSum(0.0f),
+      m_blockCount(0) {
+  // input buffer has to fit whole frame also with overlapping frames
+  set_relative_rate(1, std::max(frameSize, frameStep));
+  set_tag_propagation_policy(gr::TPP_DONT);
+}
+
+void FramePicker::forecast(int noutput_items, gr_vector_int& ninput_items_required) { ninput_items_required[0] = (noutput_items - 1) * m_frameStep + m_frameSize; }
+
+int FramePicker::general_work(int noutput_items, gr_vector_int& ninput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
+  const gr_complex* in = static_cast<const gr_complex*>(input_items[0]);
+  gr_complex* out = static_cast<gr_complex*>(output_items[0]);
+
+  const auto start = nitems_read(0);
+  const auto end = start + ninput_items[0];
+  get_tags_in_window(m_retuneTags, 0, 0, ninput_items[0], RETUNE_TAG);
+  get_tags_in_window(m_timeTags.tags(), 0, 0, ninput_items[0], TIME_TAG);
+
+  auto offset = start;
+  int produced = 0;
+  size_t tagIndex = 0;
+  while (offset < end && produced < noutput_items) {
+    while (tagIndex < m_retuneTags.size() && m_retuneTags[tagIndex].offset <= offset) {
+      retune(m_retuneTags[tagIndex++]);
+    }
+    // samples up to next retune tag are received with the same frequency
+    const auto next = tagIndex < m_retuneTags.size() ? m_retuneTags[tagIndex].offset : end;
+    measure(in + (offset - start), offset, next);
+
+    if (m_range < 0) {
+      offset = next;
+      continue;
+    }
+    if (offset < m_frameOffset) {
+      // settle samples and samples between frames are skipped
+      offset = std::min(next, m_frameOffset);
+      continue;
+    }
+
+    if (next - offset < static_cast<uint64_t>(m_frameSize)) {
+      if (next == end) {
+        // incomplete frame waits for more samples
+        break;
+      }
+      offset = next;
+      continue;
+    }
+    if (m_isRangeTagPending) {
+      add_item_tag(0, nitems_written(0) + produced, RANGE_TAG, makeRangeTag(m_range));
+      m_isRangeTagPending = false;
+    }
+    add_item_tag(0, nitems_written(0) + produced, TIME_TAG, makeTimeTag(m_timeTags.getExactTime(offset)));
+    std::memcpy(out + produced * m_frameSize, in + (offset - start), sizeof(gr_complex) * m_frameSize);
+    produced++;
+    m_frameOffset = offset + m_frameStep;
+  }
+
+  consume(0, offset - start);
+  return produced;
+}
+
+void FramePicker::retune(const gr::tag_t& tag) {
+  const auto frequency = readRetuneTag(tag.value);
+  const auto it = std::find_if(m_ranges.begin(), m_ranges.end(), [frequency](const FrequencyRange& range) { return range.center() == frequency; });
+  m_range = it != m_ranges.end() ? std::distance(m_ranges.begin(), it) : -1;
+  m_isRangeTagPending = 0 <= m_range;
+  m_isMeasuring = 0 <= m_range;
+  if (0 <= m_range) {
+    m_frameOffset = tag.offset + m_settleEstimator.getSettleSamples();
+    m_measureOffset = tag.offset;
+    m_powers.clear();
+    m_blockSum = 0.0f;
+    m_blockCount = 0;
+  }
+}
+
+void FramePicker::measure(const gr_complex* data, const uint64_t offset, const uint64_t end) {
+  // samples are measured once, also when they are not consumed in this call
+  if (!m_isMeasuring || end <= m_measureOffset) {
+    return;
+  }
+  const auto blockSize = m_settleEstimator.getBlockSize();
+  for (auto i = std::max(offset, m_measureOffset); i < end; ++i) {
+    m_blockSum += std::norm(data[i - offset]);
+    if (++m_blockCount == blockSize) {
+      m_powers.push_back(10.0f * std::log10(m_blockSum / blockSize));
+      m_blockSum = 0.0f;
+      m_blockCount = 0;
+      if (static_cast<int>(m_powers.size()) == m_settleEstimator.getBlocks()) {
+        m_settleEstimator.addMeasurement(m_powers);
+        m_isMeasuring = false;
+        Logger::trace(LABEL, "range: {}, settle samples: {}", formatFrequencyRange(m_ranges[m_range]), m_settleEstimator.getSettleSamples());
+        break;
+      }
+    }
+  }
+  m_measureOffset = end;
+}
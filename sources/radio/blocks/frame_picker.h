@@ -0,0 +1,39 @@
+#pragma once
+
+#include <gnuradio/block.h>
+#include <radio/help_structures.h>
+#include <radio/settle_estimator.h>
+#include <radio/stream_tags.h>
+
+#include <vector>
+
+// picks frames from sample stream, only kept frames are copied, samples between frames are consumed without touching them
+// frame step smaller than frame size gives overlapping frames, bigger one decimates frames
+// samples are dropped until retune tag with frequency of scanned range plus device settle samples, frame broken by retune is dropped
+// first frame after retune is tagged with range index
+class FramePicker : virtual public gr::block {
+ public:
+  FramePicker(const int frameSize, const int frameStep, const Frequency sampleRate, const std::vector<FrequencyRange>& ranges, SettleEstimator& settleEstimator);
+
+  void forecast(int noutput_items, gr_vector_int& ninput_items_required) override;
+  int general_work(int noutput_items, gr_vector_int& ninput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+ private:
+  void retune(const gr::tag_t& tag);
+  void measure(const gr_complex* data, const uint64_t offset, const uint64_t end);
+
+  const int m_frameSize;
+  const int m_frameStep;
+  const std::vector<FrequencyRange> m_ranges;
+  SettleEstimator& m_settleEstimator;
+  TimeTagReader m_timeTags;
+  std::vector<gr::tag_t> m_retuneTags;
+  int m_range;
+  bool m_isRangeTagPending;
+  uint64_t m_frameOffset;
+  bool m_isMeasuring;
+  uint64_t m_measureOffset;
+  std::vector<float> m_powers;
+  float m_blockSum;
+  int m_blockCount;
+};
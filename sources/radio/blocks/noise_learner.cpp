@@ -6,16 +6,16 @@
 
 constexpr auto LABEL = "noise";
 
-NoiseLearner::Noise::Noise() : m_startLearningTime(getTime()), m_samples(0), m_isReady(false) {}
+NoiseLearner::Noise::Noise(const int size) : m_threshold(size, -std::numeric_limits<float>::max()), m_startLearningTime(0), m_samples(0), m_isReady(false) {}
 
 bool NoiseLearner::Noise::add(const float* data, const int size) {
   if (m_isReady) {
     return true;
   }
-  if (static_cast<int>(m_threshold.size()) < size) {
-    m_threshold.resize(size, -std::numeric_limits<float>::max());
-  }
   const auto now = getTime();
+  if (m_samples == 0) {
+    m_startLearningTime = now;
+  }
   for (int i = 0; i < size; ++i) {
     m_threshold[i] = std::max(m_threshold[i], data[i]);
   }
@@ -27,41 +27,56 @@ bool NoiseLearner::Noise::add(const float* data, const int size) {
   return false;
 }
 
-NoiseLearner::NoiseLearner(int itemSize, std::function<Frequency()> getFrequency, std::function<Frequency(const int index)> indexToFrequency)
+NoiseLearner::NoiseLearner(int itemSize, const std::vector<FrequencyRange>& ranges, std::function<Frequency(const Frequency center, const int index)> indexToFrequency)
     : gr::sync_block("NoiseLearner", gr::io_signature::make(1, 1, sizeof(float) * itemSize), gr::io_signature::make(1, 1, sizeof(float) * itemSize)),
       m_itemSize(itemSize),
-      m_getFrequency(getFrequency),
-      m_indexToFrequency(indexToFrequency) {}
+      m_ranges(ranges),
+      m_indexToFrequency(indexToFrequency),
+      m_noise(ranges.size(), Noise(itemSize)) {}
 
 int NoiseLearner::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
   const float* input_buf = static_cast<const float*>(input_items[0]);
   float* output_buf = static_cast<float*>(output_items[0]);
 
-  std::unique_lock<std::mutex> lock(m_mutex);
-  const auto frequency = m_getFrequency();
-  auto& noise = m_noise[frequency];
+  get_tags_in_window(m_rangeTags.tags(), 0, 0, noutput_items, RANGE_TAG);
   for (int i = 0; i < noutput_items; ++i) {
     const auto fitIndex = i * m_itemSize;
-    if (!noise.m_isReady) {
-      if (noise.add(&input_buf[fitIndex], m_itemSize)) {
-        Logger::info(LABEL, "learning completed, frequency: {}", formatFrequency(frequency));
-      }
-      setNoData(&output_buf[fitIndex], m_itemSize);
-      continue;
-    }
+    process(m_rangeTags.getRange(nitems_read(0) + i), &input_buf[fitIndex], &output_buf[fitIndex]);
+  }
+
+  return noutput_items;
+}
 
-    int maxIndex = 0;
-    for (int j = 0; j < m_itemSize; ++j) {
-      output_buf[fitIndex + j] = input_buf[fitIndex + j] - noise.m_threshold[j];
-      if (input_buf[fitIndex + maxIndex] < input_buf[fitIndex + j]) {
-        maxIndex = j;
-      }
+const float* NoiseLearner::getNoise(const int range) const { return m_noise[range].m_isReady ? m_noise[range].m_threshold.data() : nullptr; }
+
+void NoiseLearner::process(const int range, const float* input, float* output) {
+  if (range < 0) {
+    setNoData(output, m_itemSize);
+    return;
+  }
+
+  const auto center = m_ranges[range].center();
+  auto& noise = m_noise[range];
+  if (!noise.m_isReady) {
+    if (noise.add(input, m_itemSize)) {
+      Logger::info(LABEL, "learning completed, frequency: {}", formatFrequency(center));
     }
+    setNoData(output, m_itemSize);
+    return;
+  }
 
-    const auto frequency = m_indexToFrequency(maxIndex);
-    const auto maxValue = output_buf[fitIndex + maxIndex];
-    Logger::trace(LABEL, "best signal, frequency: {}, power: {}", formatFrequency(frequency), formatPower(maxValue));
+  int maxIndex = 0;
+  for (int j = 0; j < m_itemSize; ++j) {
+    output[j] = input[j] - noise.m_threshold[j];
+    if (input[maxIndex] < input[j]) {
+      maxIndex = j;
+    }
   }
 
-  return noutput_items;
+  if (!Logger::isEnabled(spdlog::level::trace)) {
+    return;
+  }
+  const auto frequency = m_indexToFrequency(center, maxIndex);
+  const auto maxValue = output[maxIndex];
+  Logger::trace(LABEL, "best signal, frequency: {}, power: {}", formatFrequency(frequency), formatPower(maxValue));
 }
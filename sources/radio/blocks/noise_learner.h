@@ -2,14 +2,15 @@
 
 #include <gnuradio/sync_block.h>
 #include <radio/help_structures.h>
+#include <radio/stream_tags.h>
 
 #include <functional>
-#include <map>
+#include <vector>
 
 class NoiseLearner : virtual public gr::sync_block {
  private:
   struct Noise {
-    Noise();
+    Noise(const int size);
 
     std::vector<float> m_threshold;
     std::chrono::milliseconds m_startLearningTime;
@@ -20,14 +21,17 @@ class NoiseLearner : virtual public gr::sync_block {
   };
 
  public:
-  NoiseLearner(const int itemSize, std::function<Frequency()> getFrequency, std::function<Frequency(const int index)> indexToFrequency);
+  NoiseLearner(const int itemSize, const std::vector<FrequencyRange>& ranges, std::function<Frequency(const Frequency center, const int index)> indexToFrequency);
 
   int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+  void process(const int range, const float* input, float* output);
+  // learned noise of range, null while it is learned
+  const float* getNoise(const int range) const;
 
  private:
   const int m_itemSize;
-  const std::function<Frequency()> m_getFrequency;
-  const std::function<Frequency(const int index)> m_indexToFrequency;
-  std::mutex m_mutex;
-  std::map<Frequency, Noise> m_noise;
-};
\ No newline at end of file
+  const std::vector<FrequencyRange> m_ranges;
+  const std::function<Frequency(const Frequency center, const int index)> m_indexToFrequency;
+  RangeTagReader m_rangeTags;
+  std::vector<Noise> m_noise;
+};
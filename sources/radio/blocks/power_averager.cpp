@@ -0,0 +1,74 @@
+#include "power_averager.h"
+
+#include <utils/dsp_utils.h>
+
+#include <algorithm>
+#include <cmath>
+
+constexpr auto LABEL = "power averager";
+
+PowerAverager::PowerAverager(const int itemSize, const int factor, const Frequency sampleRate, const double itemRate)
+    : gr::block("PowerAverager", gr::io_signature::make(1, 1, sizeof(gr_complex) * itemSize), gr::io_signature::make(1, 1, sizeof(float) * itemSize)),
+      m_performanceLogger(LABEL),
+      m_itemSize(itemSize),
+      m_factor(factor),
+      m_powerOffset(-10.0f * std::log10(static_cast<float>(sampleRate)) - 10.0f * std::log10(static_cast<float>(factor))),
+      m_timeTags(itemRate),
+      m_sum(itemSize, 0.0f),
+      m_count(0),
+      m_range(-1),
+      m_isRangeTagPending(false),
+      m_groupTime(0) {
+  set_relative_rate(1, factor);
+  set_tag_propagation_policy(gr::TPP_DONT);
+}
+
+void PowerAverager::forecast(int noutput_items, gr_vector_int& ninput_items_required) { ninput_items_required[0] = noutput_items * m_factor; }
+
+int PowerAverager::general_work(int noutput_items, gr_vector_int& ninput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
+  const gr_complex* in = static_cast<const gr_complex*>(input_items[0]);
+  float* out = static_cast<float*>(output_items[0]);
+
+  const auto start = nitems_read(0);
+  get_tags_in_window(m_rangeTags, 0, 0, ninput_items[0], RANGE_TAG);
+  get_tags_in_window(m_timeTags.tags(), 0, 0, ninput_items[0], TIME_TAG);
+
+  int consumed = 0;
+  int produced = 0;
+  size_t tagIndex = 0;
+  while (consumed < ninput_items[0] && produced < noutput_items) {
+    const auto offset = start + consumed;
+    while (tagIndex < m_rangeTags.size() && m_rangeTags[tagIndex].offset <= offset) {
+      m_range = readRangeTag(m_rangeTags[tagIndex++].value);
+      m_isRangeTagPending = true;
+      m_count = 0;
+    }
+    if (m_range < 0) {
+      consumed++;
+      continue;
+    }
+
+    if (m_count == 0) {
+      std::fill(m_sum.begin(), m_sum.end(), 0.0f);
+      m_groupTime = m_timeTags.getExactTime(offset);
+    }
+    addPower(in + consumed * m_itemSize, m_sum.data(), m_itemSize);
+    consumed++;
+    if (++m_count < m_factor) {
+      continue;
+    }
+
+    m_performanceLogger.kick();
+    if (m_isRangeTagPending) {
+      add_item_tag(0, nitems_written(0) + produced, RANGE_TAG, makeRangeTag(m_range));
+      m_isRangeTagPending = false;
+    }
+    add_item_tag(0, nitems_written(0) + produced, TIME_TAG, makeTimeTag(m_groupTime));
+    linearToDb(m_sum.data(), out + produced * m_itemSize, m_itemSize, m_powerOffset);
+    produced++;
+    m_count = 0;
+  }
+
+  consume(0, consumed);
+  return produced;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <gnuradio/block.h>
+#include <performance_logger.h>
+#include <radio/help_structures.h>
+#include <radio/stream_tags.h>
+
+#include <vector>
+
+// welch averaging, linear power of every fft frame is summed and each group of frames gives one frame in decibels
+// group is restarted by range tag, incomplete group of previous range is dropped
+class PowerAverager : virtual public gr::block {
+ public:
+  PowerAverager(const int itemSize, const int factor, const Frequency sampleRate, const double itemRate);
+
+  void forecast(int noutput_items, gr_vector_int& ninput_items_required) override;
+  int general_work(int noutput_items, gr_vector_int& ninput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+ private:
+  PerformanceLogger m_performanceLogger;
+  const int m_itemSize;
+  const int m_factor;
+  const float m_powerOffset;
+  TimeTagReader m_timeTags;
+  std::vector<gr::tag_t> m_rangeTags;
+  std::vector<float> m_sum;
+  int m_count;
+  int m_range;
+  bool m_isRangeTagPending;
+  std::chrono::nanoseconds m_groupTime;
+};
@@ -1,5 +1,9 @@
 #include "psd.h"
 
+#include <utils/dsp_utils.h>
+
+#include <cmath>
+
 constexpr auto LABEL = "PSD";
 
 PSD::PSD(int itemSize, Frequency sample_rate)
@@ -15,8 +19,6 @@ int PSD::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vect
   for (int i = 0; i < noutput_items; ++i) {
     m_performanceLogger.kick();
   }
-  for (int i = 0; i < m_itemSize * noutput_items; ++i) {
-    output_buf[i] = 10.0f * std::log10(std::pow(std::abs(input_buf[i]), 2.0f) / m_sampleRate);
-  }
+  powerToDb(input_buf, output_buf, m_itemSize * noutput_items, -10.0f * std::log10(static_cast<float>(m_sampleRate)));
   return noutput_items;
 }
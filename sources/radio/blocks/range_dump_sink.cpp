@@ -0,0 +1,36 @@
+#include "range_dump_sink.h"
+
+#include <radio/stream_tags.h>
+#include <utils/radio_utils.h>
+
+#include <algorithm>
+
+RangeDumpSink::RangeDumpSink(const Config& config, const Device& device, const std::vector<FrequencyRange>& ranges)
+    : gr::sync_block("RangeDumpSink", gr::io_signature::make(1, 1, sizeof(gr_complex)), gr::io_signature::make(0, 0, 0)), m_ranges(ranges), m_range(-1) {
+  for (const auto& range : m_ranges) {
+    const auto fileName = getRawFileName(config.workDir(), device, "source", "fc", range.center(), device.sample_rate);
+    m_files.push_back(std::make_unique<std::ofstream>(fileName, std::ios::binary));
+  }
+}
+
+int RangeDumpSink::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star&) {
+  const gr_complex* in = static_cast<const gr_complex*>(input_items[0]);
+  get_tags_in_window(m_tags, 0, 0, noutput_items, RETUNE_TAG);
+
+  const auto start = nitems_read(0);
+  auto offset = start;
+  for (size_t i = 0; i <= m_tags.size(); ++i) {
+    // samples up to next retune tag are received with the same frequency
+    const auto next = i < m_tags.size() ? m_tags[i].offset : start + noutput_items;
+    if (0 <= m_range && offset < next) {
+      m_files[m_range]->write(reinterpret_cast<const char*>(in + (offset - start)), sizeof(gr_complex) * (next - offset));
+    }
+    if (i < m_tags.size()) {
+      const auto frequency = readRetuneTag(m_tags[i].value);
+      const auto it = std::find_if(m_ranges.begin(), m_ranges.end(), [frequency](const FrequencyRange& range) { return range.center() == frequency; });
+      m_range = it != m_ranges.end() ? std::distance(m_ranges.begin(), it) : -1;
+    }
+    offset = next;
+  }
+  return noutput_items;
+}
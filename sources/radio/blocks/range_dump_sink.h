@@ -0,0 +1,24 @@
+#pragma once
+
+#include <config.h>
+#include <gnuradio/sync_block.h>
+#include <radio/help_structures.h>
+
+#include <fstream>
+#include <memory>
+#include <vector>
+
+// writes raw IQ of every scanned range to its own file, ranges are switched by retune tags
+// samples of frequencies outside of ranges are dropped, so every file holds only samples of its center frequency
+class RangeDumpSink : virtual public gr::sync_block {
+ public:
+  RangeDumpSink(const Config& config, const Device& device, const std::vector<FrequencyRange>& ranges);
+
+  int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+ private:
+  const std::vector<FrequencyRange> m_ranges;
+  std::vector<std::unique_ptr<std::ofstream>> m_files;
+  std::vector<gr::tag_t> m_tags;
+  int m_range;
+};
@@ -1,15 +1,30 @@
 #include "sdr_source.h"
 
 #include <SoapySDR/Formats.h>
+#include <config.h>
 #include <logger.h>
 #include <utils/utils.h>
+#include <volk/volk.h>
 
 #include <SoapySDR/Errors.hpp>
+#include <SoapySDR/Formats.hpp>
+#include <cstring>
 
 constexpr auto LABEL = "source";
+constexpr auto READER_STATS_LOG_INTERVAL = std::chrono::seconds(10);
+constexpr auto READER_WAIT_TIME = std::chrono::milliseconds(50);
 
 SdrSource::SdrSource(const Device& device)
-    : gr::sync_block("SdrSource", gr::io_signature::make(0, 0, 0), gr::io_signature::make(1, 1, sizeof(gr_complex))), m_configDevice(device), m_device(nullptr), m_stream(nullptr) {
+    : gr::sync_block("SdrSource", gr::io_signature::make(0, 0, 0), gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      Source(device.sample_rate, true),
+      m_configDevice(device),
+      m_device(nullptr),
+      m_stream(nullptr),
+      m_fullScale(1.0f),
+      m_isReading(false),
+      m_deviceOverflows(0),
+      m_lastOverflows(0),
+      m_lostSamples(0) {
   m_device = SoapySDR::Device::make(fmt::format("driver={},serial={}", device.driver, device.serial));
   m_device->setGainMode(SOAPY_SDR_RX, 0, false);
   for (const auto& gain : device.gains) {
@@ -26,13 +41,14 @@ SdrSource::~SdrSource() {
 }
 
 int SdrSource::work(int noutput_items, gr_vector_const_void_star&, gr_vector_void_star& output_items) {
-  int flags = 0;
-  long long int time_ns = 0;
-  const long timeout_us = 500000;  // 0.5 sec
+  if (m_ring) {
+    return readRing(static_cast<gr_complex*>(output_items[0]), noutput_items);
+  }
 
   std::lock_guard<std::mutex> lock(m_mutex);
-  const auto result = m_device->readStream(m_stream, output_items.data(), noutput_items, flags, time_ns, timeout_us);
+  const auto result = read(static_cast<gr_complex*>(output_items[0]), noutput_items);
   if (0 <= result) {
+    addTags(result);
     return result;
   } else {
     Logger::error(LABEL, "soapy error: {}", SoapySDR::errToStr(result));
@@ -48,14 +64,55 @@ int SdrSource::general_work(int noutput_items, gr_vector_int&, gr_vector_const_v
 
 bool SdrSource::start() {
   std::lock_guard<std::mutex> lock(m_mutex);
-  m_stream = m_device->setupStream(SOAPY_SDR_RX, SOAPY_SDR_CF32);
-  set_max_noutput_items(std::max(static_cast<size_t>(1024), m_device->getStreamMTU(m_stream)));
+  resetTime();
+  double fullScale = 0.0;
+  const auto nativeFormat = m_device->getNativeStreamFormat(SOAPY_SDR_RX, 0, fullScale);
+  if ((nativeFormat == SOAPY_SDR_CS8 || nativeFormat == SOAPY_SDR_CS16) && 0.0 < fullScale) {
+    m_format = nativeFormat;
+    m_fullScale = fullScale;
+  } else {
+    m_format = SOAPY_SDR_CF32;
+    m_fullScale = 1.0f;
+  }
+  Logger::info(LABEL, "native stream format: {}, used stream format: {}, full scale: {}", colored(GREEN, "{}", nativeFormat), colored(GREEN, "{}", m_format), colored(GREEN, "{}", m_fullScale));
+
+  m_stream = m_device->setupStream(SOAPY_SDR_RX, m_format);
+  const auto maxItems = std::max(static_cast<size_t>(1024), m_device->getStreamMTU(m_stream));
+  set_max_noutput_items(maxItems);
+  if (m_format != SOAPY_SDR_CF32) {
+    m_buffer.resize(maxItems * SoapySDR::formatToSize(m_format));
+  }
   m_device->activateStream(m_stream);
+
+  if (m_configDevice.reader_thread) {
+    const auto capacity = static_cast<size_t>(m_configDevice.sample_rate * std::chrono::duration<double>(SOURCE_READER_BUFFER_TIME).count());
+    m_ring = std::make_unique<RingBuffer<gr_complex>>(std::max(capacity, 4 * maxItems));
+    m_dropBuffer.resize(maxItems);
+    m_lastStatsTime = std::chrono::steady_clock::now();
+    m_lastOverflows = 0;
+    m_lostSamples = 0;
+    m_isReading = true;
+    m_thread = std::thread([this]() { readerThread(); });
+    if (0 <= m_configDevice.reader_cpu && !setThreadAffinity(m_thread, m_configDevice.reader_cpu)) {
+      Logger::warn(LABEL, "can not pin reader thread to cpu: {}", colored(RED, "{}", m_configDevice.reader_cpu));
+    }
+    Logger::info(
+        LABEL,
+        "reader thread started, buffer: {}, cpu: {}",
+        colored(GREEN, "{} samples", m_ring->capacity()),
+        colored(GREEN, "{}", m_configDevice.reader_cpu));
+  }
   return true;
 }
 
 bool SdrSource::stop() {
   std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_thread.joinable()) {
+    m_isReading = false;
+    m_thread.join();
+    std::lock_guard<std::mutex> readerLock(m_readerMutex);
+    m_readerCondition.notify_one();
+  }
   if (m_stream) {
     m_device->deactivateStream(m_stream);
     m_device->closeStream(m_stream);
@@ -64,11 +121,115 @@ bool SdrSource::stop() {
   return true;
 }
 
+int SdrSource::read(gr_complex* data, const int count) {
+  int flags = 0;
+  long long int time_ns = 0;
+  const long timeout_us = 500000;  // 0.5 sec
+
+  if (m_format == SOAPY_SDR_CF32) {
+    void* buffers[] = {data};
+    return m_device->readStream(m_stream, buffers, count, flags, time_ns, timeout_us);
+  }
+
+  // read native format and convert to float here, cheaper than driver conversion
+  const auto maxCount = std::min(count, static_cast<int>(m_buffer.size() / SoapySDR::formatToSize(m_format)));
+  void* buffers[] = {m_buffer.data()};
+  const auto result = m_device->readStream(m_stream, buffers, maxCount, flags, time_ns, timeout_us);
+  if (0 < result) {
+    float* output = reinterpret_cast<float*>(data);
+    if (m_format == SOAPY_SDR_CS8) {
+      volk_8i_s32f_convert_32f(output, reinterpret_cast<const int8_t*>(m_buffer.data()), m_fullScale, 2 * result);
+    } else {
+      volk_16i_s32f_convert_32f(output, reinterpret_cast<const int16_t*>(m_buffer.data()), m_fullScale, 2 * result);
+    }
+  }
+  return result;
+}
+
+int SdrSource::readRing(gr_complex* data, const int count) {
+  // wait shortly for samples, returning empty output from time to time lets scheduler stop the block
+  {
+    std::unique_lock<std::mutex> lock(m_readerMutex);
+    m_readerCondition.wait_for(lock, READER_WAIT_TIME, [this]() { return m_ring->size() != 0 || !m_isReading; });
+  }
+
+  int total = 0;
+  while (total < count) {
+    const auto slice = m_ring->readSlice();
+    if (slice.empty()) {
+      break;
+    }
+    const auto size = std::min(static_cast<int>(slice.size()), count - total);
+    std::memcpy(data + total, slice.data(), size * sizeof(gr_complex));
+    m_ring->commitRead(size);
+    total += size;
+  }
+
+  const auto lostSamples = m_ring->overflows() + m_deviceOverflows;
+  if (lostSamples != m_lostSamples) {
+    m_lostSamples = lostSamples;
+    resetTime();
+  }
+  addTags(total, m_ring->size());
+  logReaderStats();
+  return total;
+}
+
+void SdrSource::readerThread() {
+  while (m_isReading) {
+    // when ring is full samples are still read from device and dropped, so driver buffers never overflow
+    const auto slice = m_ring->writeSlice();
+    const auto isFull = slice.empty();
+    gr_complex* data = isFull ? m_dropBuffer.data() : slice.data();
+    const auto count = static_cast<int>(isFull ? m_dropBuffer.size() : std::min(slice.size(), m_dropBuffer.size()));
+
+    const auto result = read(data, count);
+    if (0 < result) {
+      if (isFull) {
+        m_ring->addOverflow(result);
+      } else {
+        m_ring->commitWrite(result);
+        std::lock_guard<std::mutex> lock(m_readerMutex);
+        m_readerCondition.notify_one();
+      }
+    } else if (result == SOAPY_SDR_OVERFLOW) {
+      m_deviceOverflows++;
+    } else if (result < 0) {
+      Logger::error(LABEL, "soapy error: {}", SoapySDR::errToStr(result));
+      exit(1);
+    }
+  }
+}
+
+void SdrSource::logReaderStats() {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastStatsTime < READER_STATS_LOG_INTERVAL) {
+    return;
+  }
+  const auto overflows = m_ring->overflows();
+  const auto fill = 100.0 * m_ring->size() / m_ring->capacity();
+  if (m_lastOverflows < overflows) {
+    Logger::warn(
+        LABEL,
+        "reader buffer fill: {}, dropped samples: {}, device overflows: {}",
+        colored(RED, "{:.1f}%", fill),
+        colored(RED, "{}", overflows - m_lastOverflows),
+        colored(RED, "{}", m_deviceOverflows.load()));
+  } else {
+    Logger::debug(LABEL, "reader buffer fill: {}, device overflows: {}", colored(GREEN, "{:.1f}%", fill), colored(GREEN, "{}", m_deviceOverflows.load()));
+  }
+  m_lastStatsTime = now;
+  m_lastOverflows = overflows;
+}
+
 bool SdrSource::setCenterFrequency(Frequency frequency) {
   std::lock_guard<std::mutex> lock(m_mutex);
+  // samples read while device is retuning belong to no frequency, retune tag marks first of them and settle samples cover them
+  const auto offset = m_ring ? m_ring->written() : 0;
   for (int i = 0; i < 10; ++i) {
     try {
       m_device->setFrequency(SOAPY_SDR_RX, 0, frequency);
+      setRetuned(frequency, offset);
       return true;
     } catch (const std::exception&) {
     }
@@ -1,12 +1,20 @@
 #pragma once
 
-#include <gnuradio/sync_block.h>
+#include <radio/blocks/source.h>
 #include <radio/help_structures.h>
+#include <utils/ring_buffer.h>
 
 #include <SoapySDR/Device.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
-class SdrSource : virtual public gr::sync_block {
+class SdrSource : public Source {
  public:
   SdrSource(const Device& device);
   ~SdrSource();
@@ -17,11 +25,31 @@ class SdrSource : virtual public gr::sync_block {
   bool start() override;
   bool stop() override;
 
-  bool setCenterFrequency(Frequency frequency);
+  bool setCenterFrequency(Frequency frequency) override;
 
  private:
+  int read(gr_complex* data, const int count);
+  int readRing(gr_complex* data, const int count);
+  void readerThread();
+  void logReaderStats();
+
   const Device m_configDevice;
   std::mutex m_mutex;
   SoapySDR::Device* m_device;
   SoapySDR::Stream* m_stream;
+  std::string m_format;
+  float m_fullScale;
+  std::vector<uint8_t> m_buffer;
+
+  std::unique_ptr<RingBuffer<gr_complex>> m_ring;
+  std::vector<gr_complex> m_dropBuffer;
+  std::atomic<bool> m_isReading;
+  // reader thread wakes work after every write to ring
+  std::mutex m_readerMutex;
+  std::condition_variable m_readerCondition;
+  std::atomic<uint64_t> m_deviceOverflows;
+  std::thread m_thread;
+  std::chrono::steady_clock::time_point m_lastStatsTime;
+  uint64_t m_lastOverflows;
+  uint64_t m_lostSamples;
 };
\ No newline at end of file
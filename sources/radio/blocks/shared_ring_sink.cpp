@@ -0,0 +1,16 @@
+#include "shared_ring_sink.h"
+
+#include <radio/stream_tags.h>
+
+SharedRingSink::SharedRingSink(const std::string& name, const uint64_t capacity, const Frequency sampleRate)
+    : gr::sync_block("SharedRingSink", gr::io_signature::make(1, 1, sizeof(gr_complex)), gr::io_signature::make(0, 0, 0)), m_writer(name, capacity, sampleRate) {}
+
+int SharedRingSink::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star&) {
+  // readers learn new frequency before samples after retune are visible
+  get_tags_in_window(m_tags, 0, 0, noutput_items, RETUNE_TAG);
+  for (const auto& tag : m_tags) {
+    m_writer.setRetune(readRetuneTag(tag.value), tag.offset);
+  }
+  m_writer.write(static_cast<const gr_complex*>(input_items[0]), noutput_items);
+  return noutput_items;
+}
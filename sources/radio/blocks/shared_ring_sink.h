@@ -0,0 +1,21 @@
+#pragma once
+
+#include <gnuradio/sync_block.h>
+#include <radio/help_structures.h>
+#include <utils/shared_ring.h>
+
+#include <string>
+#include <vector>
+
+// exports raw stream to named shared memory ring for external processes, retune tags are stored in ring header
+// ring cursor is equal to offset of input item, so cursor of retune is offset of its tag
+class SharedRingSink : virtual public gr::sync_block {
+ public:
+  SharedRingSink(const std::string& name, const uint64_t capacity, const Frequency sampleRate);
+
+  int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+ private:
+  SharedRingWriter m_writer;
+  std::vector<gr::tag_t> m_tags;
+};
@@ -0,0 +1,71 @@
+#include "source.h"
+
+#include <config.h>
+#include <logger.h>
+#include <radio/stream_tags.h>
+
+#include <algorithm>
+
+constexpr auto LABEL = "source";
+
+Source::Source(const Frequency sampleRate, const bool followSystemClock)
+    : m_sampleRate(sampleRate),
+      m_followSystemClock(followSystemClock),
+      m_isAnchored(false),
+      m_anchorOffset(0),
+      m_anchorTime(0),
+      m_isRetunePending(false),
+      m_retuneFrequency(0),
+      m_retuneOffset(0) {}
+
+void Source::addTags(const int count, const uint64_t bufferedSamples) {
+  if (count <= 0) {
+    return;
+  }
+  addTimeTag(count, bufferedSamples);
+  addRetuneTag(count);
+}
+
+void Source::resetTime() { m_isAnchored = false; }
+
+void Source::setRetuned(const Frequency frequency, const uint64_t offset) {
+  // called from other thread than work
+  m_retuneFrequency = frequency;
+  m_retuneOffset = offset;
+  m_isRetunePending.store(true, std::memory_order_release);
+}
+
+void Source::addTimeTag(const int count, const uint64_t bufferedSamples) {
+  // time is sample counter anchored once to system clock, one tag per output buffer instead of clock call per item
+  const auto offset = nitems_written(0);
+  const auto time = m_anchorTime + samplesToTime(offset - m_anchorOffset);
+  if (!m_isAnchored || m_followSystemClock) {
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()) - samplesToTime(count + bufferedSamples);
+    const auto drift = std::chrono::abs(now - time);
+    if (!m_isAnchored || SOURCE_MAX_TIME_DRIFT < drift) {
+      if (m_isAnchored) {
+        Logger::debug(LABEL, "time drift: {}, anchoring again", colored(RED, "{} ms", std::chrono::duration_cast<std::chrono::milliseconds>(drift).count()));
+      }
+      m_isAnchored = true;
+      m_anchorOffset = offset;
+      m_anchorTime = now;
+    }
+  }
+  add_item_tag(0, offset, TIME_TAG, makeTimeTag(m_anchorTime + samplesToTime(offset - m_anchorOffset)));
+}
+
+void Source::addRetuneTag(const int count) {
+  if (!m_isRetunePending.load(std::memory_order_acquire)) {
+    return;
+  }
+  const auto offset = std::max(m_retuneOffset.load(), nitems_written(0));
+  if (offset < nitems_written(0) + count) {
+    add_item_tag(0, offset, RETUNE_TAG, makeRetuneTag(m_retuneFrequency.load()));
+    m_isRetunePending.store(false, std::memory_order_relaxed);
+  }
+}
+
+std::chrono::nanoseconds Source::samplesToTime(const uint64_t samples) const {
+  const uint64_t sampleRate = m_sampleRate;
+  return std::chrono::seconds(samples / sampleRate) + std::chrono::nanoseconds(samples % sampleRate * 1000000000 / sampleRate);
+}
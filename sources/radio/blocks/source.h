@@ -0,0 +1,37 @@
+#pragma once
+
+#include <gnuradio/sync_block.h>
+#include <radio/help_structures.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+class Source : virtual public gr::sync_block {
+ public:
+  virtual bool setCenterFrequency(Frequency frequency) = 0;
+
+ protected:
+  Source(const Frequency sampleRate, const bool followSystemClock);
+
+  // tags produced items with time and pending retune, call at the end of work, buffered samples are already read but not produced yet
+  void addTags(const int count, const uint64_t bufferedSamples = 0);
+  // anchors sample counter to system clock again with next tag, call when samples were lost
+  void resetTime();
+  // marks first sample received with new frequency, offset is absolute output offset, earlier offsets tag next produced sample
+  void setRetuned(const Frequency frequency, const uint64_t offset = 0);
+
+ private:
+  void addTimeTag(const int count, const uint64_t bufferedSamples);
+  void addRetuneTag(const int count);
+  std::chrono::nanoseconds samplesToTime(const uint64_t samples) const;
+
+  const Frequency m_sampleRate;
+  const bool m_followSystemClock;
+  bool m_isAnchored;
+  uint64_t m_anchorOffset;
+  std::chrono::nanoseconds m_anchorTime;
+  std::atomic<bool> m_isRetunePending;
+  std::atomic<Frequency> m_retuneFrequency;
+  std::atomic<uint64_t> m_retuneOffset;
+};
@@ -6,16 +6,18 @@
 
 constexpr auto LABEL = "spectogram";
 
-Spectrogram::Container::Container(int size) : m_counter(0), m_lastDataSendTime(getTime()) { m_sum.resize(size); }
+Spectrogram::Container::Container(int size) : m_counter(0), m_lastDataSendTime(0) { m_sum.resize(size); }
 
-Spectrogram::Spectrogram(const int itemSize, const Frequency sampleRate, std::function<Frequency()> getFrequency, SendFunction send)
+Spectrogram::Spectrogram(const int itemSize, const Frequency sampleRate, const double itemRate, const std::vector<FrequencyRange>& ranges, SendFunction send)
     : gr::sync_block("Spectrogram", gr::io_signature::make(1, 1, sizeof(float) * itemSize), gr::io_signature::make(0, 0, 0)),
       m_inputSize(itemSize),
-      m_outputSize(std::min(SPECTROGRAM_MAX_FFT, getFft(sampleRate, SPECTROGRAM_PREFERRED_MAX_STEP))),
+      m_outputSize(std::min({itemSize, SPECTROGRAM_MAX_FFT, getFft(sampleRate, SPECTROGRAM_PREFERRED_MAX_STEP)})),
       m_decimatorFactor(m_inputSize / m_outputSize),
       m_sampleRate(sampleRate),
-      m_getFrequency(getFrequency),
-      m_send(send) {
+      m_ranges(ranges),
+      m_send(send),
+      m_timeTags(itemRate),
+      m_containers(ranges.size(), Container(m_outputSize)) {
   const auto step = m_sampleRate / m_outputSize;
   Logger::info(
       LABEL,
@@ -29,14 +31,20 @@ Spectrogram::Spectrogram(const int itemSize, const Frequency sampleRate, std::fu
 int Spectrogram::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star&) {
   const float* in = static_cast<const float*>(input_items[0]);
 
+  get_tags_in_window(m_timeTags.tags(), 0, 0, noutput_items, TIME_TAG);
+  get_tags_in_window(m_rangeTags.tags(), 0, 0, noutput_items, RANGE_TAG);
   for (int i = 0; i < noutput_items; ++i) {
-    const auto frequency = m_getFrequency();
-    auto it = m_containers.find(frequency);
-    if (it == m_containers.end()) {
-      it = m_containers.emplace(frequency, m_outputSize).first;
+    const auto now = m_timeTags.getTime(nitems_read(0) + i);
+    const auto range = m_rangeTags.getRange(nitems_read(0) + i);
+    if (range < 0) {
+      continue;
     }
-    process(it->second, &in[i * m_inputSize]);
-    send(it->second);
+    auto& container = m_containers[range];
+    if (container.m_lastDataSendTime.count() == 0) {
+      container.m_lastDataSendTime = now;
+    }
+    process(container, &in[i * m_inputSize]);
+    send(container, m_ranges[range].center(), now);
   }
 
   return noutput_items;
@@ -59,9 +67,7 @@ void Spectrogram::process(Container& container, const float* data) {
   container.m_counter++;
 }
 
-void Spectrogram::send(Container& container) {
-  const auto now = getTime();
-  const auto frequency = m_getFrequency();
+void Spectrogram::send(Container& container, const Frequency frequency, const std::chrono::milliseconds now) {
   if (container.m_lastDataSendTime + SPECTROGRAM_SEND_INTERVAL < now) {
     std::vector<int8_t> tmp(m_outputSize);
     for (int j = 0; j < m_outputSize; ++j) {
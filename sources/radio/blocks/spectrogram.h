@@ -2,6 +2,7 @@
 
 #include <gnuradio/sync_block.h>
 #include <radio/help_structures.h>
+#include <radio/stream_tags.h>
 
 #include <functional>
 #include <vector>
@@ -18,19 +19,21 @@ class Spectrogram : virtual public gr::sync_block {
   using SendFunction = std::function<void(const std::chrono::milliseconds&, const Frequency&, const std::vector<int8_t>&)>;
 
  public:
-  Spectrogram(const int itemSize, const Frequency sampleRate, std::function<Frequency()> getFrequency, SendFunction send);
+  Spectrogram(const int itemSize, const Frequency sampleRate, const double itemRate, const std::vector<FrequencyRange>& ranges, SendFunction send);
 
   int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
 
  private:
   void process(Container& container, const float* data);
-  void send(Container& container);
+  void send(Container& container, const Frequency frequency, const std::chrono::milliseconds now);
 
   const int m_inputSize;
   const int m_outputSize;
   const int m_decimatorFactor;
   const Frequency m_sampleRate;
-  const std::function<Frequency()> m_getFrequency;
+  const std::vector<FrequencyRange> m_ranges;
   const SendFunction m_send;
-  std::map<Frequency, Container> m_containers;
+  TimeTagReader m_timeTags;
+  RangeTagReader m_rangeTags;
+  std::vector<Container> m_containers;
 };
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "stream_gate.h"
+
+#include <algorithm>
+#include <cstring>
+
+StreamGate::StreamGate(const Frequency sampleRate, const int historySize, std::function<bool()> isOpen)
+    : gr::block("StreamGate", gr::io_signature::make(1, 1, sizeof(gr_complex)), gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      m_sampleRate(sampleRate),
+      m_isOpen(isOpen),
+      m_timeTags(sampleRate),
+      m_history(historySize),
+      m_historyHead(0),
+      m_historyCount(0),
+      m_historyEndTime(0),
+      m_isReplaying(false) {
+  set_tag_propagation_policy(gr::TPP_DONT);
+}
+
+int StreamGate::general_work(int noutput_items, gr_vector_int& ninput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
+  const gr_complex* in = static_cast<const gr_complex*>(input_items[0]);
+  gr_complex* out = static_cast<gr_complex*>(output_items[0]);
+
+  get_tags_in_window(m_timeTags.tags(), 0, 0, ninput_items[0], TIME_TAG);
+  if (!m_isOpen()) {
+    // time reader is kept up to date also for dropped samples
+    m_historyEndTime = m_timeTags.getExactTime(nitems_read(0) + ninput_items[0]);
+    store(in, ninput_items[0]);
+    m_isReplaying = false;
+    consume(0, ninput_items[0]);
+    return 0;
+  }
+
+  if (0 < m_historyCount) {
+    // input waits until history is passed, history ends right before it
+    if (!m_isReplaying) {
+      const auto delta = std::chrono::duration<double>(static_cast<double>(m_historyCount) / m_sampleRate);
+      add_item_tag(0, nitems_written(0), TIME_TAG, makeTimeTag(m_historyEndTime - std::chrono::duration_cast<std::chrono::nanoseconds>(delta)));
+      m_isReplaying = true;
+    }
+    return replay(out, noutput_items);
+  }
+  m_isReplaying = false;
+
+  const auto count = std::min(noutput_items, ninput_items[0]);
+  add_item_tag(0, nitems_written(0), TIME_TAG, makeTimeTag(m_timeTags.getExactTime(nitems_read(0))));
+  std::memcpy(out, in, sizeof(gr_complex) * count);
+  consume(0, count);
+  return count;
+}
+
+void StreamGate::store(const gr_complex* data, const int count) {
+  const auto size = static_cast<int>(m_history.size());
+  // only last samples fit into history
+  const auto skip = std::max(0, count - size);
+  for (int i = skip; i < count;) {
+    const auto part = std::min(count - i, size - m_historyHead);
+    std::memcpy(m_history.data() + m_historyHead, data + i, sizeof(gr_complex) * part);
+    m_historyHead = (m_historyHead + part) % size;
+    i += part;
+  }
+  m_historyCount = std::min(size, m_historyCount + count);
+}
+
+int StreamGate::replay(gr_complex* data, const int count) {
+  const auto size = static_cast<int>(m_history.size());
+  const auto total = std::min(count, m_historyCount);
+  for (int i = 0; i < total;) {
+    const auto offset = (m_historyHead - m_historyCount + size) % size;
+    const auto part = std::min(total - i, size - offset);
+    std::memcpy(data + i, m_history.data() + offset, sizeof(gr_complex) * part);
+    m_historyCount -= part;
+    i += part;
+  }
+  return total;
+}
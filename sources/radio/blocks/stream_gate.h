@@ -0,0 +1,31 @@
+#pragma once
+
+#include <gnuradio/block.h>
+#include <radio/help_structures.h>
+#include <radio/stream_tags.h>
+
+#include <functional>
+#include <vector>
+
+// passes stream only while it is open, closed gate consumes samples without producing them so blocks behind it stay idle
+// closed gate keeps last history samples, they are passed first when gate opens, so blocks behind it get samples from before it opened
+// every passed part gets time tag of its first sample, other tags are not propagated
+class StreamGate : virtual public gr::block {
+ public:
+  StreamGate(const Frequency sampleRate, const int historySize, std::function<bool()> isOpen);
+
+  int general_work(int noutput_items, gr_vector_int& ninput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+ private:
+  void store(const gr_complex* data, const int count);
+  int replay(gr_complex* data, const int count);
+
+  const Frequency m_sampleRate;
+  const std::function<bool()> m_isOpen;
+  TimeTagReader m_timeTags;
+  std::vector<gr_complex> m_history;
+  int m_historyHead;
+  int m_historyCount;
+  std::chrono::nanoseconds m_historyEndTime;
+  bool m_isReplaying;
+};
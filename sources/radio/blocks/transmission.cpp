@@ -2,113 +2,174 @@
 
 #include <config.h>
 #include <logger.h>
+#include <utils/dsp_utils.h>
+#include <utils/radio_utils.h>
 #include <utils/utils.h>
 
+#include <numeric>
+
 constexpr auto LABEL = "transmission";
 
+Transmission::Slot::Slot(const FrequencyRange& range, const int itemSize, const int groupingX, const int groupingY, const std::vector<uint8_t>& allowedIndexes)
+    : m_range(range), m_allowedIndexes(allowedIndexes), m_averager(itemSize, groupingY, groupingX) {}
+
 Transmission::Transmission(
     const Config& config,
     const Device& device,
     const int itemSize,
     const int groupSize,
+    const int binRatio,
+    const double itemRate,
+    const std::vector<FrequencyRange>& ranges,
     TransmissionNotification& notification,
-    std::function<Frequency()> getFrequency,
-    std::function<Frequency(const Index index)> indexToFrequency,
+    std::function<Frequency(const Frequency center, const Index index)> indexToFrequency,
     std::function<Frequency(const Index index)> indexToShift,
-    std::function<bool(const int Index)> isIndexInRange)
+    std::shared_ptr<ZoomTable> zoomTable)
     : gr::sync_block("Transmission", gr::io_signature::make(1, 1, sizeof(float) * itemSize), gr::io_signature::make(0, 0, 0)),
       m_config(config),
       m_device(device),
       m_itemSize(itemSize),
       m_groupSize(groupSize),
-      m_averager(itemSize, GROUPING_Y),
+      m_isCfar(device.detection_mode == CFAR_DETECTION_MODE),
+      m_cfarGuard(0 < device.cfar_guard ? scaleBins(device.cfar_guard, binRatio) : groupSize),
+      m_cfarReference(0 < device.cfar_reference ? scaleBins(device.cfar_reference, binRatio) : CFAR_REFERENCE_GROUPS * groupSize),
+      m_historyLevel(m_isCfar ? -std::numeric_limits<float>::max() : device.start_recording_level),
+      m_timeTags(itemRate),
       m_notification(notification),
-      m_getFrequency(getFrequency),
       m_indexToFrequency(indexToFrequency),
       m_indexToShift(indexToShift),
-      m_isIndexInRange(isIndexInRange) {
-  Logger::info(LABEL, "group size: {}", colored(GREEN, "{}", m_groupSize));
+      m_zoomTable(zoomTable),
+      m_slot(nullptr),
+      m_indexes(itemSize),
+      m_prefix(m_isCfar ? itemSize + 1 : 0),
+      m_cfar(m_isCfar ? itemSize : 0),
+      m_bestIndexes(0, groupSize / 2) {
+  // zero is set only in configs created before grouping was configurable
+  // grouping in frequency is counted in full resolution bins, detection bins are wider with zoom detection
+  const auto groupingX = scaleBins(0 < device.grouping_x ? device.grouping_x : DEFAULT_GROUPING_X, binRatio);
+  const auto groupingY = 0 < device.grouping_y ? device.grouping_y : DEFAULT_GROUPING_Y;
+  Logger::info(LABEL, "group size: {}, grouping x: {}, grouping y: {}", colored(GREEN, "{}", m_groupSize), colored(GREEN, "{}", groupingX), colored(GREEN, "{}", groupingY));
+  if (!m_isCfar && !device.detection_mode.empty()) {
+    Logger::warn(LABEL, "unknown detection mode: {}, using level detection", colored(RED, "{}", device.detection_mode));
+  }
+  if (m_isCfar) {
+    Logger::info(LABEL, "cfar detection, guard: {}, reference: {}", colored(GREEN, "{}", m_cfarGuard), colored(GREEN, "{}", m_cfarReference));
+  }
+  m_slots.reserve(ranges.size());
+  const auto ignoredRanges = m_config.ignoredRanges();
+  for (const auto& range : ranges) {
+    const auto center = range.center();
+    m_slots.emplace_back(range, itemSize, groupingX, groupingY, getAllowedIndexes(range, ignoredRanges, itemSize, [this, center](const Index index) { return m_indexToFrequency(center, index); }));
+  }
 }
 
 int Transmission::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star&) {
   const float* input_buf = static_cast<const float*>(input_items[0]);
 
-  std::unique_lock<std::mutex> lock(m_mutex);
+  get_tags_in_window(m_timeTags.tags(), 0, 0, noutput_items, TIME_TAG);
+  get_tags_in_window(m_rangeTags.tags(), 0, 0, noutput_items, RANGE_TAG);
   for (int i = 0; i < noutput_items; ++i) {
-    process(&input_buf[i * m_itemSize]);
+    process(m_rangeTags.getRange(nitems_read(0) + i), &input_buf[i * m_itemSize], m_timeTags.getTime(nitems_read(0) + i));
   }
 
   return noutput_items;
 }
 
-void Transmission::process(const float* power) {
-  m_averager.push(power);
-  const auto bufferPower = m_averager.average();
-  std::vector<float> avgPower(bufferPower.size(), 0.0);
-  average(bufferPower.data(), avgPower.data(), bufferPower.size(), GROUPING_X);
-
-  const auto now = getTime();
-  addSignals(avgPower.data(), power, now);
-  updateSignals(avgPower.data(), power, now);
-  clearSignals(avgPower.data(), power, now);
-  m_notification.notify(getSortedTransmissions(now));
+void Transmission::process(const int range, const float* power, const std::chrono::milliseconds now) {
+  if (range < 0) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_slot = &m_slots[range];
+  m_slot->m_averager.push(power);
+  detect(power, now);
+}
+
+void Transmission::process(const int range, const std::complex<float>* frame, const float* noise, float* power, const float offset, const std::chrono::milliseconds now) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_slot = &m_slots[range];
+  auto& averager = m_slot->m_averager;
+  averager.push(frame, noise, power, offset);
+  // newest history row is frame without noise
+  detect(averager.row(averager.rows() - 1), now);
+}
+
+void Transmission::detect(const float* power, const std::chrono::milliseconds now) {
+  auto avgPower = m_slot->m_averager.average().data();
+  if (m_isCfar) {
+    // levels are relative to neighbour bins, smoothed frame is replaced by its cfar output
+    cfar(avgPower, m_prefix.data(), m_cfar.data(), m_itemSize, m_cfarGuard, m_cfarReference);
+    avgPower = m_cfar.data();
+  }
+
+  addSignals(avgPower, power, now);
+  updateSignals(avgPower, power, now);
+  clearSignals(avgPower, power, now);
+  updateTransmissions(now);
+  m_notification.notify(m_transmissions);
 }
 
 void Transmission::clearSignals(const float*, const float*, const std::chrono::milliseconds now) {
-  for (auto it = m_signals.begin(); it != m_signals.cend();) {
-    const auto& [index, signal] = *it;
+  std::erase_if(m_slot->m_signals, [this, now](const std::pair<Index, Signal>& kv) {
+    const auto& [index, signal] = kv;
     if (signal.isTimeout(now) || signal.isMaximalTime(now)) {
-      const auto bestTunedFrequency = getTunedFrequency(m_indexToFrequency(index), m_config.recordingTuningStep());
+      const auto bestTunedFrequency = getTunedFrequency(indexToFrequency(index), m_config.recordingTuningStep());
       Logger::info(
           LABEL,
           "signal: {}, stop: {}, center: {}",
-          formatFrequency(m_indexToFrequency(index), BROWN),
+          formatFrequency(indexToFrequency(index), BROWN),
           formatFrequency(bestTunedFrequency, CYAN),
-          formatFrequency(m_indexToFrequency(signal.getIndex()), MAGENTA));
-      m_signals.erase(it++);
-    } else {
-      it++;
+          formatFrequency(indexToFrequency(signal.getIndex()), MAGENTA));
+      return true;
     }
-  }
+    return false;
+  });
 }
 
 void Transmission::addSignals(const float* avgPower, const float* rawPower, const std::chrono::milliseconds now) {
-  std::vector<Index> indexes;
-  for (int i = 0; i < m_itemSize; ++i) {
-    if (m_device.start_recording_level <= avgPower[i] && m_isIndexInRange(i) && !isIndexIgnored(i)) {
-      indexes.push_back(i);
-    }
-  }
-  std::sort(indexes.begin(), indexes.end(), [avgPower](const Index& i1, const Index& i2) { return avgPower[i1] > avgPower[i2]; });
+  const auto count = selectIndexes(avgPower, m_slot->m_allowedIndexes.data(), m_device.start_recording_level, m_itemSize, m_indexes.data());
+  // candidates covered by existing signals are dropped before sorting, only new signals need power order
+  const auto begin = m_indexes.begin();
+  const auto end = std::remove_if(begin, begin + count, [this](const Index index) { return containsWithMargin(m_slot->m_signals, index, m_groupSize).has_value(); });
+  std::sort(begin, end, [avgPower](const Index& i1, const Index& i2) { return avgPower[i1] > avgPower[i2]; });
 
-  for (const auto& index : indexes) {
-    if (!containsWithMargin(m_signals, index, m_groupSize)) {
+  for (auto it = begin; it != end; ++it) {
+    const auto index = *it;
+    if (!containsWithMargin(m_slot->m_signals, index, m_groupSize)) {
       const auto bestIndex = getBestIndex(index);
-      const auto bestTunedFrequency = getTunedFrequency(m_indexToFrequency(bestIndex), m_config.recordingTuningStep());
+      const auto bestTunedFrequency = getTunedFrequency(indexToFrequency(bestIndex), m_config.recordingTuningStep());
       Logger::info(
           LABEL,
           "signal: {}, start: {}, avg power: {}, raw power: {}",
-          formatFrequency(m_indexToFrequency(bestIndex), BROWN),
+          formatFrequency(indexToFrequency(bestIndex), BROWN),
           formatFrequency(bestTunedFrequency, CYAN),
           formatPower(avgPower[bestIndex], BROWN),
           formatPower(rawPower[bestIndex], BROWN));
-      m_signals.insert({bestIndex, {m_config, m_device, m_indexToFrequency, m_indexToShift, now}});
+      auto& signals = m_slot->m_signals;
+      const auto it = std::lower_bound(signals.begin(), signals.end(), bestIndex, [](const std::pair<Index, Signal>& kv, const Index value) { return kv.first < value; });
+      if (it == signals.end() || it->first != bestIndex) {
+        signals.emplace(it, bestIndex, Signal(m_config, m_device, bestIndex, m_groupSize, now));
+      }
     }
   }
 }
 
 void Transmission::updateSignals(const float* avgPower, const float* rawPower, const std::chrono::milliseconds now) {
-  for (auto& [index, signal] : m_signals) {
+  for (auto& [index, signal] : m_slot->m_signals) {
     const auto bestAvgIndex = getMaxIndex(avgPower, m_itemSize, index, m_groupSize);
     const auto bestRawIndex = getMaxIndex(rawPower, m_itemSize, index, m_groupSize);
     signal.newData(bestAvgIndex, avgPower[bestAvgIndex], bestRawIndex, rawPower[bestRawIndex], now);
+    if (!Logger::isEnabled(spdlog::level::debug)) {
+      continue;
+    }
     Logger::debug(
         LABEL,
         "signal: {}, best avg: {}, {}, best raw: {}, {}, d: {:5d} ms, ld: {:5d} ms ago, fl: {}",
-        formatFrequency(m_indexToFrequency(index), BROWN),
-        formatFrequency(m_indexToFrequency(bestAvgIndex), CYAN),
+        formatFrequency(indexToFrequency(index), BROWN),
+        formatFrequency(indexToFrequency(bestAvgIndex), CYAN),
         formatPower(avgPower[bestAvgIndex], CYAN),
-        formatFrequency(m_indexToFrequency(bestRawIndex), MAGENTA),
+        formatFrequency(indexToFrequency(bestRawIndex), MAGENTA),
         formatPower(rawPower[bestRawIndex], MAGENTA),
         signal.getDuration().count(),
         signal.getLastDataTime(now).count(),
@@ -116,51 +177,65 @@ void Transmission::updateSignals(const float* avgPower, const float* rawPower, c
   }
 }
 
-Transmission::Index Transmission::getBestIndex(Index index) const {
-  std::vector<Transmission::Index> buffer;
-  const auto min = m_averager.data().size() / 2;
-  const auto max = m_averager.data().size();
-  for (size_t i = min; i < max; ++i) {
-    const auto& row = m_averager.data().at(i);
-    const auto bestIndex = getMaxIndex(row.data(), row.size(), index, m_groupSize);
-    if (m_device.start_recording_level <= row[bestIndex]) {
+Transmission::Index Transmission::getBestIndex(Index index) {
+  m_bestIndexes.reset(index);
+  const auto min = m_slot->m_averager.rows() / 2;
+  const auto max = m_slot->m_averager.rows();
+  for (int i = min; i < max; ++i) {
+    const auto row = m_slot->m_averager.row(i);
+    const auto bestIndex = getMaxIndex(row, m_itemSize, index, m_groupSize);
+    if (m_historyLevel <= row[bestIndex]) {
       const int timestamp = max - i - 1;
       Logger::debug(
           LABEL,
           "signal: {}, time: {}, best: {}, raw: {}",
-          formatFrequency(m_indexToFrequency(index), BROWN),
+          formatFrequency(indexToFrequency(index), BROWN),
           -timestamp,
-          formatFrequency(m_indexToFrequency(bestIndex), MAGENTA),
+          formatFrequency(indexToFrequency(bestIndex), MAGENTA),
           formatPower(row[bestIndex], MAGENTA));
-      buffer.push_back(bestIndex);
+      m_bestIndexes.add(bestIndex);
     }
   }
-  const auto mostFrequentIndex = mostFrequentValue(buffer);
-  Logger::debug(LABEL, "signal: {}, best: {}", formatFrequency(m_indexToFrequency(index), BROWN), formatFrequency(m_indexToFrequency(mostFrequentIndex), CYAN));
+  const auto mostFrequentIndex = m_bestIndexes.mode();
+  Logger::debug(LABEL, "signal: {}, best: {}", formatFrequency(indexToFrequency(index), BROWN), formatFrequency(indexToFrequency(mostFrequentIndex), CYAN));
   return mostFrequentIndex;
 }
 
-bool Transmission::isIndexIgnored(const Index& index) const {
-  const auto frequency = m_indexToFrequency(index);
-  for (const auto& range : m_config.ignoredRanges()) {
-    if (range.contains(frequency)) {
-      return true;
+Frequency Transmission::indexToFrequency(const Index index) const { return m_indexToFrequency(m_slot->m_range.center(), index); }
+
+void Transmission::updateTransmissions(const std::chrono::milliseconds now) {
+  auto& signals = m_slot->m_signals;
+  if (m_zoomTable) {
+    // shift of signal is refined once by zoom fft, signal is not reported until its refined shift is known
+    const auto range = static_cast<int>(m_slot - m_slots.data());
+    m_zoomIndexes.clear();
+    for (auto& [index, signal] : signals) {
+      if (!signal.getShift()) {
+        const auto shift = m_zoomTable->getShift(range, index);
+        if (shift) {
+          signal.setShift(*shift);
+        } else {
+          m_zoomIndexes.push_back(index);
+        }
+      }
     }
+    m_zoomTable->setIndexes(range, m_zoomIndexes);
   }
-  return false;
-}
 
-std::vector<Recording> Transmission::getSortedTransmissions(const std::chrono::milliseconds now) const {
-  std::vector<Index> indexes;
-  std::transform(m_signals.begin(), m_signals.end(), std::back_inserter(indexes), [](auto& kv) { return kv.first; });
-  std::sort(indexes.begin(), indexes.end(), [this](const Index& i1, const Index& i2) { return m_signals.at(i1).getPower() > m_signals.at(i2).getPower(); });
-  std::vector<Recording> transmissions;
-  for (const auto& index : indexes) {
-    const auto deviceFrequency = m_getFrequency();
-    const auto shiftFrequency = getTunedFrequency(m_indexToShift(index), m_config.recordingTuningStep());
+  m_order.resize(signals.size());
+  std::iota(m_order.begin(), m_order.end(), 0);
+  std::sort(m_order.begin(), m_order.end(), [&signals](const int i1, const int i2) { return signals[i1].second.getPower() > signals[i2].second.getPower(); });
+
+  m_transmissions.clear();
+  for (const auto& position : m_order) {
+    const auto& [index, signal] = signals[position];
+    if (m_zoomTable && !signal.getShift()) {
+      continue;
+    }
+    const auto deviceFrequency = m_slot->m_range.center();
+    const auto shiftFrequency = getTunedFrequency(signal.getShift().value_or(m_indexToShift(index)), m_config.recordingTuningStep());
     const auto source = m_device.alias.empty() ? SCANNER_SOURCE_NAME : GAIN_TESTER_SOURCE_NAME;
     const auto name = m_device.alias.empty() ? SCANNER_RECORDING_NAME : GAIN_TESTER_RECORDING_NAME;
-    transmissions.emplace_back(source, name, deviceFrequency, deviceFrequency + shiftFrequency, m_config.recordingBandwidth(), "", m_signals.at(index).needFlush(now));
+    m_transmissions.emplace_back(source, name, deviceFrequency, deviceFrequency + shiftFrequency, m_config.recordingBandwidth(), "", signal.needFlush(now), now);
   }
-  return transmissions;
 }
@@ -4,48 +4,83 @@
 #include <gnuradio/sync_block.h>
 #include <radio/averager.h>
 #include <radio/help_structures.h>
+#include <radio/mode_estimator.h>
 #include <radio/signal.h>
+#include <radio/stream_tags.h>
+#include <radio/zoom_table.h>
 
 #include <atomic>
+#include <memory>
 #include <mutex>
-#include <set>
+#include <vector>
 
 class Transmission : virtual public gr::sync_block {
   using Index = int;
 
+  struct Slot {
+    Slot(const FrequencyRange& range, const int itemSize, const int groupingX, const int groupingY, const std::vector<uint8_t>& allowedIndexes);
+
+    const FrequencyRange m_range;
+    const std::vector<uint8_t> m_allowedIndexes;
+    Averager m_averager;
+    // flat table sorted by index, capacity is kept when signals are removed
+    std::vector<std::pair<Index, Signal>> m_signals;
+  };
+
  public:
   Transmission(
       const Config& config,
       const Device& device,
       const int itemSize,
       const int groupSize,
+      const int binRatio,
+      const double itemRate,
+      const std::vector<FrequencyRange>& ranges,
       TransmissionNotification& notification,
-      std::function<Frequency()> getFrequency,
-      std::function<Frequency(const int index)> indexToFrequency,
+      std::function<Frequency(const Frequency center, const int index)> indexToFrequency,
       std::function<Frequency(const int index)> indexToShift,
-      std::function<bool(const int Index)> isIndexInRange);
+      std::shared_ptr<ZoomTable> zoomTable);
 
   int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+  void process(const int range, const float* power, const std::chrono::milliseconds now);
+  // fused variant, power of frame is computed, written to output and pushed to averager without noise in one pass
+  void process(const int range, const std::complex<float>* frame, const float* noise, float* power, const float offset, const std::chrono::milliseconds now);
 
  private:
-  void process(const float* power);
+  void detect(const float* power, const std::chrono::milliseconds now);
   void clearSignals(const float* avgPower, const float* rawPower, const std::chrono::milliseconds now);
   void addSignals(const float* avgPower, const float* rawPower, const std::chrono::milliseconds now);
   void updateSignals(const float* avgPower, const float* rawPower, const std::chrono::milliseconds now);
-  Index getBestIndex(Index index) const;
-  bool isIndexIgnored(const Index& index) const;
-  std::vector<Recording> getSortedTransmissions(const std::chrono::milliseconds now) const;
+  Index getBestIndex(Index index);
+  Frequency indexToFrequency(const Index index) const;
+  void updateTransmissions(const std::chrono::milliseconds now);
 
   const Config& m_config;
   const Device& m_device;
   const int m_itemSize;
   const int m_groupSize;
-  Averager m_averager;
+  const bool m_isCfar;
+  const int m_cfarGuard;
+  const int m_cfarReference;
+  // history rows are checked against start level only when detection uses absolute levels
+  const float m_historyLevel;
+  TimeTagReader m_timeTags;
+  RangeTagReader m_rangeTags;
   TransmissionNotification& m_notification;
-  const std::function<Frequency()> m_getFrequency;
-  const std::function<Frequency(const Index index)> m_indexToFrequency;
+  const std::function<Frequency(const Frequency center, const Index index)> m_indexToFrequency;
   const std::function<Frequency(const Index index)> m_indexToShift;
-  const std::function<bool(const Index index)> m_isIndexInRange;
+  // refined shifts of signals, null when zoom detection is disabled
+  const std::shared_ptr<ZoomTable> m_zoomTable;
   std::mutex m_mutex;
-  std::map<Index, Signal> m_signals;
+  std::vector<Slot> m_slots;
+  Slot* m_slot;
+  // scratch buffers reused by every frame
+  // candidate bins of current frame, sized for all bins
+  std::vector<Index> m_indexes;
+  std::vector<double> m_prefix;
+  std::vector<float> m_cfar;
+  ModeEstimator m_bestIndexes;
+  std::vector<int> m_order;
+  std::vector<Index> m_zoomIndexes;
+  std::vector<Recording> m_transmissions;
 };
@@ -0,0 +1,74 @@
+#include "zoom_fft.h"
+
+#include <config.h>
+#include <gnuradio/fft/window.h>
+#include <utils/dsp_utils.h>
+
+#include <algorithm>
+#include <cmath>
+
+constexpr auto LABEL = "zoom fft";
+
+ZoomFft::ZoomFft(const int frameSize, const int coarseSize, const Frequency sampleRate, std::shared_ptr<ZoomTable> zoomTable, std::function<Frequency(const int index)> indexToShift)
+    : gr::sync_block("ZoomFft", gr::io_signature::make(1, 1, sizeof(gr_complex) * frameSize), gr::io_signature::make(1, 1, sizeof(float) * coarseSize)),
+      m_performanceLogger(LABEL),
+      m_frameSize(frameSize),
+      m_coarseSize(coarseSize),
+      m_coarseStep(sampleRate / coarseSize),
+      m_segments(std::clamp(frameSize / coarseSize, 1, ZOOM_COARSE_SEGMENTS)),
+      m_powerOffset(-10.0f * std::log10(static_cast<float>(sampleRate)) - 10.0f * std::log10(static_cast<float>(m_segments))),
+      m_zoomTable(zoomTable),
+      m_indexToShift(indexToShift),
+      m_window(gr::fft::window::hamming(coarseSize)),
+      m_fft(coarseSize),
+      m_zoomEstimator(frameSize, std::max(1, coarseSize / ZOOM_SPAN_COARSE_BINS), sampleRate),
+      m_sum(coarseSize) {}
+
+int ZoomFft::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
+  const gr_complex* input_buf = static_cast<const gr_complex*>(input_items[0]);
+  float* output_buf = static_cast<float*>(output_items[0]);
+
+  get_tags_in_window(m_rangeTags.tags(), 0, 0, noutput_items, RANGE_TAG);
+  for (int i = 0; i < noutput_items; ++i) {
+    m_performanceLogger.kick();
+    const auto frame = &input_buf[static_cast<size_t>(i) * m_frameSize];
+    coarse(frame, &output_buf[static_cast<size_t>(i) * m_coarseSize]);
+    const auto range = m_rangeTags.getRange(nitems_read(0) + i);
+    if (0 <= range) {
+      zoom(range, frame);
+    }
+  }
+
+  return noutput_items;
+}
+
+void ZoomFft::coarse(const gr_complex* frame, float* output) {
+  // welch average of few segments, spectrum is shifted to have zero frequency in the middle
+  const auto half = m_coarseSize / 2;
+  const auto stride = m_frameSize / m_segments;
+  std::fill(m_sum.begin(), m_sum.end(), 0.0f);
+  for (int segment = 0; segment < m_segments; ++segment) {
+    const auto offset = segment * stride;
+    gr_complex* in = m_fft.get_inbuf();
+    for (int i = 0; i < m_coarseSize; ++i) {
+      in[i] = frame[offset + i] * m_window[i];
+    }
+    m_fft.execute();
+    const gr_complex* out = m_fft.get_outbuf();
+    addPower(out + half, m_sum.data(), m_coarseSize - half);
+    addPower(out, m_sum.data() + m_coarseSize - half, half);
+  }
+  linearToDb(m_sum.data(), output, m_coarseSize, m_powerOffset);
+}
+
+void ZoomFft::zoom(const int range, const gr_complex* frame) {
+  m_zoomTable->getIndexes(range, m_indexes);
+  if (m_indexes.empty()) {
+    return;
+  }
+  m_shifts.clear();
+  for (const auto index : m_indexes) {
+    m_shifts.emplace_back(index, m_zoomEstimator.estimate(frame, m_indexToShift(index), m_coarseStep));
+  }
+  m_zoomTable->setShifts(range, m_shifts);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <gnuradio/fft/fft.h>
+#include <gnuradio/sync_block.h>
+#include <performance_logger.h>
+#include <radio/help_structures.h>
+#include <radio/stream_tags.h>
+#include <radio/zoom_estimator.h>
+#include <radio/zoom_table.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+// coarse then zoom detection, every long frame gives coarse power spectrum averaged over few short segments
+// zoom fft with full frame resolution is computed only around coarse indexes requested by transmission
+class ZoomFft : virtual public gr::sync_block {
+ public:
+  ZoomFft(const int frameSize, const int coarseSize, const Frequency sampleRate, std::shared_ptr<ZoomTable> zoomTable, std::function<Frequency(const int index)> indexToShift);
+
+  int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+ private:
+  void coarse(const gr_complex* frame, float* output);
+  void zoom(const int range, const gr_complex* frame);
+
+  PerformanceLogger m_performanceLogger;
+  const int m_frameSize;
+  const int m_coarseSize;
+  const Frequency m_coarseStep;
+  const int m_segments;
+  const float m_powerOffset;
+  const std::shared_ptr<ZoomTable> m_zoomTable;
+  const std::function<Frequency(const int index)> m_indexToShift;
+  const std::vector<float> m_window;
+  gr::fft::fft_complex_fwd m_fft;
+  ZoomEstimator m_zoomEstimator;
+  RangeTagReader m_rangeTags;
+  std::vector<float> m_sum;
+  std::vector<int> m_indexes;
+  std::vector<std::pair<int, Frequency>> m_shifts;
+};
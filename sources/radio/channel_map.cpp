@@ -0,0 +1,34 @@
+#include "channel_map.h"
+
+#include <config.h>
+
+#include <cmath>
+
+namespace {
+int getCount(const Frequency sampleRate, const Frequency spacing, const Frequency bandwidth) {
+  // twice oversampled channelizer needs even count, recording has to fit into single channel
+  const auto count = 2 * (sampleRate / spacing / 2);
+  if (count < RECORDER_CHANNEL_MIN_COUNT || sampleRate / count <= bandwidth) {
+    return 0;
+  }
+  return count;
+}
+}  // namespace
+
+ChannelMap::ChannelMap(const Frequency sampleRate, const Frequency spacing, const Frequency bandwidth)
+    : m_count(getCount(sampleRate, spacing, bandwidth)), m_spacing(0 < m_count ? static_cast<double>(sampleRate) / m_count : static_cast<double>(sampleRate)) {}
+
+int ChannelMap::count() const { return m_count; }
+
+double ChannelMap::spacing() const { return m_spacing; }
+
+Frequency ChannelMap::rate() const { return static_cast<Frequency>(std::lround(2.0 * m_spacing)); }
+
+int ChannelMap::getChannel(const Frequency shift) const {
+  const auto index = getIndex(shift) % m_count;
+  return static_cast<int>(index < 0 ? index + m_count : index);
+}
+
+Frequency ChannelMap::getResidual(const Frequency shift) const { return static_cast<Frequency>(std::lround(shift - getIndex(shift) * m_spacing)); }
+
+long ChannelMap::getIndex(const Frequency shift) const { return std::lround(shift / m_spacing); }
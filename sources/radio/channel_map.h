@@ -0,0 +1,24 @@
+#pragma once
+
+#include <radio/help_structures.h>
+
+// device band split by polyphase channelizer into equally spaced channels, channel k is centered at k * spacing
+// channels above half of count wrap to negative frequencies, every channel is oversampled twice
+// so signal is never cut by channel edge, recording is taken from nearest channel and shifted by residual frequency
+class ChannelMap {
+ public:
+  ChannelMap(const Frequency sampleRate, const Frequency spacing, const Frequency bandwidth);
+
+  // zero when band is too narrow to be split, recorders use full rate stream then
+  int count() const;
+  double spacing() const;
+  Frequency rate() const;
+  int getChannel(const Frequency shift) const;
+  Frequency getResidual(const Frequency shift) const;
+
+ private:
+  long getIndex(const Frequency shift) const;
+
+  const int m_count;
+  const double m_spacing;
+};
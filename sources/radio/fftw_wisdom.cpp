@@ -0,0 +1,55 @@
+#include "fftw_wisdom.h"
+
+#include <fftw3.h>
+#include <gnuradio/fft/fft.h>
+#include <logger.h>
+#include <utils/radio_utils.h>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+constexpr auto LABEL = "fftw wisdom";
+
+namespace {
+std::string getCpuName() {
+  // x86 reports model name, arm boards report model
+  std::ifstream file("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.starts_with("model name") || line.starts_with("Model")) {
+      const auto position = line.find(':');
+      if (position != std::string::npos) {
+        return line.substr(position + 1);
+      }
+    }
+  }
+  return "";
+}
+
+std::string getFileName(const Config& config) { return getWisdomFileName(config.workDir(), getCpuName(), static_cast<int>(std::thread::hardware_concurrency())); }
+}  // namespace
+
+void importFftwWisdom(const Config& config) {
+  const auto fileName = getFileName(config);
+  if (!std::filesystem::exists(fileName)) {
+    Logger::info(LABEL, "no wisdom file, ffts will be planned: {}", colored(GREEN, "{}", fileName));
+    return;
+  }
+  gr::fft::planner::scoped_lock lock(gr::fft::planner::mutex());
+  if (fftwf_import_wisdom_from_filename(fileName.c_str())) {
+    Logger::info(LABEL, "imported: {}", colored(GREEN, "{}", fileName));
+  } else {
+    Logger::warn(LABEL, "import failed: {}", colored(RED, "{}", fileName));
+  }
+}
+
+void exportFftwWisdom(const Config& config) {
+  const auto fileName = getFileName(config);
+  gr::fft::planner::scoped_lock lock(gr::fft::planner::mutex());
+  if (fftwf_export_wisdom_to_filename(fileName.c_str())) {
+    Logger::debug(LABEL, "exported: {}", colored(GREEN, "{}", fileName));
+  } else {
+    Logger::warn(LABEL, "export failed: {}", colored(RED, "{}", fileName));
+  }
+}
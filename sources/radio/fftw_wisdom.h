@@ -0,0 +1,9 @@
+#pragma once
+
+#include <config.h>
+
+// fftw wisdom is global for process, detection fft and gnuradio fft blocks plan with the same wisdom
+// it is stored in work directory, separate file for every cpu, plans inside are keyed by fft size
+void importFftwWisdom(const Config& config);
+
+void exportFftwWisdom(const Config& config);
@@ -3,6 +3,7 @@
 #include <notification.h>
 #include <utils/serializers.h>
 
+#include <chrono>
 #include <complex>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -18,6 +19,8 @@ struct Recording {
   Frequency bandwidth;
   std::string modulation;
   bool flush;
+  // time of frame that reported this recording, zero for scheduled recordings
+  std::chrono::milliseconds detectionTime{};
 
   Frequency shift() const { return recordingFrequency - deviceFrequency; }
 };
@@ -82,9 +85,44 @@ struct Device {
   std::vector<Satellite> satellites{};
   std::vector<Frequency> sample_rates{};
   std::vector<Crontab> crontabs;
+  bool reader_thread{};
+  int reader_cpu{-1};
+  double frame_overlap{};
+  bool frame_averaging{};
+  int grouping_x{};
+  int grouping_y{};
+  std::string detection_mode{};
+  int cfar_guard{};
+  int cfar_reference{};
+  bool zoom_detection{};
+  int fft_threads{};
 
   std::string getName() const { return driver + "_" + serial; }
   std::string getAliasName() const { return alias.empty() ? getName() : alias; }
 };
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
-    Device, connected, enabled, gains, serial, driver, alias, sample_rate, ranges, start_recording_level, stop_recording_level, satellites, sample_rates, crontabs)
+    Device,
+    connected,
+    enabled,
+    gains,
+    serial,
+    driver,
+    alias,
+    sample_rate,
+    ranges,
+    start_recording_level,
+    stop_recording_level,
+    satellites,
+    sample_rates,
+    crontabs,
+    reader_thread,
+    reader_cpu,
+    frame_overlap,
+    frame_averaging,
+    grouping_x,
+    grouping_y,
+    detection_mode,
+    cfar_guard,
+    cfar_reference,
+    zoom_detection,
+    fft_threads)
@@ -0,0 +1,36 @@
+#include "mode_estimator.h"
+
+#include <algorithm>
+
+ModeEstimator::ModeEstimator(const int center, const int radius) : m_radius(radius), m_center(center), m_total(0), m_counts(2 * radius + 1, 0) {}
+
+void ModeEstimator::add(const int value) {
+  const auto index = value - m_center + m_radius;
+  if (0 <= index && index < static_cast<int>(m_counts.size())) {
+    m_counts[index]++;
+    m_total++;
+  }
+}
+
+void ModeEstimator::reset(const int center) {
+  m_center = center;
+  m_total = 0;
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+}
+
+bool ModeEstimator::empty() const { return m_total == 0; }
+
+int ModeEstimator::mode() const {
+  if (m_total == 0) {
+    return m_center;
+  }
+  const auto maxCount = *std::max_element(m_counts.begin(), m_counts.end());
+  const auto ties = std::count(m_counts.begin(), m_counts.end(), maxCount);
+  auto middle = ties / 2;
+  for (int i = 0; i < static_cast<int>(m_counts.size()); ++i) {
+    if (m_counts[i] == maxCount && middle-- == 0) {
+      return m_center - m_radius + i;
+    }
+  }
+  return m_center;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+
+// most frequent value of stream of values close to center, memory and update cost do not depend on stream length
+// values outside of center +- radius are ignored, ties are resolved like mostFrequentValue (middle of most frequent values)
+class ModeEstimator {
+ public:
+  ModeEstimator(const int center, const int radius);
+
+  void add(const int value);
+  void reset(const int center);
+  bool empty() const;
+  // center is returned when no value was added
+  int mode() const;
+
+ private:
+  int m_radius;
+  int m_center;
+  int m_total;
+  std::vector<int> m_counts;
+};
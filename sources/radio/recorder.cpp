@@ -1,98 +1,242 @@
 #include "recorder.h"
 
 #include <config.h>
-#include <gnuradio/analog/agc2_cc.h>
-#include <gnuradio/blocks/complex_to_interleaved_char.h>
-#include <gnuradio/blocks/file_sink.h>
-#include <gnuradio/blocks/stream_to_vector.h>
-#include <gnuradio/filter/fir_filter.h>
-#include <gnuradio/filter/fir_filter_blk.h>
 #include <gnuradio/filter/firdes.h>
-#include <gnuradio/filter/freq_xlating_fir_filter.h>
-#include <gnuradio/filter/pfb_arb_resampler_ccf.h>
-#include <gnuradio/filter/rational_resampler.h>
-#include <gnuradio/zeromq/sub_source.h>
 #include <logger.h>
 #include <network/query.h>
+#include <volk/volk.h>
 
-#include <limits>
+#include <cmath>
+#include <map>
+#include <mutex>
 
 constexpr auto LABEL = "recorder";
+constexpr auto READER_STATS_LOG_INTERVAL = std::chrono::seconds(10);
+constexpr auto RESAMPLER_FILTER_SIZE = 32;
 
-// most blocks based on
+// filters based on
 // https://github.com/gqrx-sdr/gqrx/blob/master/src/applications/gqrx/receiver.cpp
 
-Block buildDecimator(Frequency sampleRate, Frequency shift, int decim) {
-  const auto filter = gr::filter::freq_xlating_fir_filter_ccf::make(decim, {1}, 0.0, sampleRate);
-  const auto outRate = sampleRate / decim;
-  const auto lpf_cutoff = 120e3;
-  filter->set_center_freq(shift);
-  filter->set_taps(gr::filter::firdes::low_pass(1.0, sampleRate, lpf_cutoff, outRate - 2 * lpf_cutoff, gr::fft::window::WIN_BLACKMAN_HARRIS));
-  return filter;
+double getResamplerRate(Frequency inputRate, Frequency outputRate) { return static_cast<double>(outputRate) / inputRate; }
+
+// taps depend only on rates, they are designed once and shared by all recorders
+std::vector<float> getDecimatorTaps(Frequency sampleRate, int decim) {
+  static std::mutex mutex;
+  static std::map<std::pair<Frequency, int>, std::vector<float>> cache;
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto key = std::make_pair(sampleRate, decim);
+  if (!cache.count(key)) {
+    const auto outRate = sampleRate / decim;
+    const auto lpf_cutoff = 120e3;
+    cache[key] = gr::filter::firdes::low_pass(1.0, sampleRate, lpf_cutoff, outRate - 2 * lpf_cutoff, gr::fft::window::WIN_BLACKMAN_HARRIS);
+  }
+  return cache.at(key);
+}
+
+std::vector<float> getResamplerTaps(Frequency inputRate, Frequency outputRate, int flt_size) {
+  static std::mutex mutex;
+  static std::map<std::pair<Frequency, Frequency>, std::vector<float>> cache;
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto key = std::make_pair(inputRate, outputRate);
+  if (!cache.count(key)) {
+    const auto rate = getResamplerRate(inputRate, outputRate);
+    const auto cutoff = rate > 1.0f ? 0.4 : 0.4 * (double)rate;
+    const auto trans_width = rate > 1.0f ? 0.2 : 0.2 * (double)rate;
+    cache[key] = gr::filter::firdes::low_pass(flt_size, flt_size, cutoff, trans_width);
+  }
+  return cache.at(key);
 }
 
-Block buildResampler(Frequency inputRate, Frequency outputRate) {
-  const auto rate = static_cast<double>(outputRate) / inputRate;
-  const auto cutoff = rate > 1.0f ? 0.4 : 0.4 * (double)rate;
-  const auto trans_width = rate > 1.0f ? 0.2 : 0.2 * (double)rate;
-  const auto flt_size = 32;
-  const auto d_taps = gr::filter::firdes::low_pass(flt_size, flt_size, cutoff, trans_width);
-  auto resampler = gr::filter::pfb_arb_resampler_ccf::make(rate, d_taps, flt_size);
-  resampler->set_output_multiple(4096);
-  return resampler;
+Recorder::Recorder(const Config& config, const Device& device, RecorderBank& bank, Frequency sampleRate, Frequency bandwidth)
+    : m_config(config),
+      m_device(device),
+      m_bank(bank),
+      m_sampleRate(sampleRate),
+      m_bandwidth(bandwidth),
+      m_decim(std::max(1, static_cast<int>(sampleRate / RECORDER_SAMPLE_RATE_DECIMATOR))),
+      m_samplesSize(roundUp(bandwidth * RECORDER_FLUSH_INTERVAL.count() / 1000, 4096)),
+      m_recording{},
+      m_decimator(getDecimatorTaps(sampleRate, m_decim)),
+      m_resampler(getResamplerRate(sampleRate / m_decim, bandwidth), getResamplerTaps(sampleRate / m_decim, bandwidth, RESAMPLER_FILTER_SIZE), RESAMPLER_FILTER_SIZE),
+      m_agc(2e-3, 2e-3, 0.585, 53),
+      m_lastLost(0),
+      m_isStarted(false),
+      m_isFirstSlice(false) {
+  m_input.assign(m_decimator.ntaps() - 1, 0);
+  m_decimated.assign(m_resampler.taps_per_filter() - 1, 0);
+  m_firstDataTime = getTime();
+  m_lastDataTime = m_firstDataTime;
+}
+
+Recorder::~Recorder() {
+  if (m_isStarted) {
+    m_bank.remove(this);
+    Logger::info(LABEL, "stop recorder, frequency: {}, time: {} ms", formatFrequency(m_recording.recordingFrequency, RED), getDuration().count());
+  }
 }
 
-Recorder::Recorder(const Config& config, const Device& device, const std::string& zeromq, Frequency sampleRate, const Recording& recording, std::function<void(const nlohmann::json&)> send)
-    : m_config(config), m_sampleRate(sampleRate), m_recording(recording), m_send(send), m_tb(gr::make_top_block("recorder")), m_connector(m_tb) {
+void Recorder::start(
+    std::shared_ptr<BroadcastRing<gr_complex>> ring,
+    std::shared_ptr<TimeAnchor> timeAnchor,
+    Frequency shift,
+    const Recording& recording,
+    std::function<void(const nlohmann::json&)> send) {
+  m_isStarted = true;
+  m_recording = recording;
+  m_send = send;
+  m_rotator.set_phase_incr(std::exp(gr_complex(0.0f, static_cast<float>(-2.0 * M_PI * shift / m_sampleRate))));
+  if (m_config.dumpRecording()) {
+    const auto fileName = getRawFileName(m_config.workDir(), m_device, "recording", "fc", m_recording.recordingFrequency, m_recording.bandwidth);
+    m_dumpFile.open(fileName, std::ios::binary);
+  }
+  m_firstDataTime = getTime();
+  m_lastDataTime = m_firstDataTime;
+  m_lastStatsTime = std::chrono::steady_clock::now();
+  // recording starts from samples of frame that reported it if they are still in ring, ring is written before detection finishes
+  const auto head = ring->written();
+  const auto position = m_recording.detectionTime.count() ? timeAnchor->getOffset(m_recording.detectionTime).value_or(head) : head;
+  m_reader = std::make_unique<BroadcastRing<gr_complex>::Reader>(ring, position);
+  m_timeAnchor = timeAnchor;
+  m_isFirstSlice = true;
   Logger::info(
       LABEL,
-      "start recorder, source: {}, name: {}, frequency: {}, bandwidth: {}, modulation: {}",
+      "start recorder, source: {}, name: {}, frequency: {}, bandwidth: {}, modulation: {}, history: {}",
       colored(BLUE, "{}", m_recording.source),
       colored(BLUE, "{}", m_recording.name),
       formatFrequency(m_recording.recordingFrequency, GREEN),
       formatFrequency(m_recording.bandwidth, GREEN),
-      colored(BLUE, "{}", m_recording.modulation));
-
-  auto source = gr::zeromq::sub_source::make(sizeof(gr_complex), 1, const_cast<char*>(zeromq.c_str()));
-  std::vector<Block> blocks;
-  blocks.push_back(source);
-  const auto decim = std::max(1, static_cast<int>(sampleRate / RECORDER_SAMPLE_RATE_DECIMATOR));
-  blocks.push_back(buildDecimator(m_sampleRate, m_recording.shift(), decim));
-  blocks.push_back(buildResampler(sampleRate / decim, m_recording.bandwidth));
-  auto raw = blocks.back();
-
-  const auto samplesSize = roundUp(m_recording.bandwidth * RECORDER_FLUSH_INTERVAL.count() / 1000, 4096);
-  blocks.push_back(gr::analog::agc2_cc::make(2e-3, 2e-3, 0.585, 53));
-  blocks.push_back(gr::blocks::complex_to_interleaved_char::make(true, 127.0));
-  blocks.push_back(gr::blocks::stream_to_vector::make(sizeof(SimpleComplex), samplesSize));
-  m_buffer = std::make_shared<Buffer<SimpleComplex>>("RecorderBuffer", samplesSize);
-  blocks.push_back(m_buffer);
-  m_connector.connect(blocks);
-
-  if (config.dumpRecording()) {
-    const auto fileName = getRawFileName(config.workDir(), device, "recording", "fc", m_recording.recordingFrequency, m_recording.bandwidth);
-    m_connector.connect<Block>(raw, gr::blocks::file_sink::make(sizeof(gr_complex), fileName.c_str()));
-  }
-
-  m_firstDataTime = getTime();
-  m_lastDataTime = m_firstDataTime;
-  m_tb->start();
+      colored(BLUE, "{}", m_recording.modulation),
+      colored(GREEN, "{} samples", head - m_reader->position()));
+  m_bank.add(this);
 }
 
-Recorder::~Recorder() {
-  Logger::info(LABEL, "stop recorder, frequency: {}, time: {} ms", formatFrequency(m_recording.recordingFrequency, RED), getDuration().count());
-  m_tb->stop();
-  m_tb->wait();
+bool Recorder::process() {
+  const auto slice = m_reader->readSlice();
+  if (slice.empty()) {
+    logReaderStats();
+    return false;
+  }
+  const auto time = m_timeAnchor->getTime(m_reader->position());
+  if (m_isFirstSlice && m_recording.detectionTime.count()) {
+    // history passed by channel gate after start may be older than frame that reported recording
+    const auto delta = std::chrono::duration<double>(m_recording.detectionTime - time).count();
+    const auto skip = std::min(slice.size(), static_cast<size_t>(std::max(0.0, std::ceil(delta * m_sampleRate))));
+    if (0 < skip) {
+      m_reader->commitRead(skip);
+      return true;
+    }
+    // latency is counted from frame that reported recording to first recorded sample
+    Logger::info(
+        LABEL,
+        "first sample, frequency: {}, latency: {}",
+        formatFrequency(m_recording.recordingFrequency, GREEN),
+        colored(GREEN, "{} ms", std::chrono::duration_cast<std::chrono::milliseconds>(time - m_recording.detectionTime).count()));
+  }
+  m_isFirstSlice = false;
+  const auto size = m_input.size();
+  m_input.resize(size + slice.size());
+  m_rotator.rotateN(m_input.data() + size, slice.data(), slice.size());
+  // samples overwritten while copying are dropped, filters continue with next slice
+  if (!m_reader->commitRead(slice.size())) {
+    m_input.resize(size);
+    return true;
+  }
+
+  decimate();
+  const auto count = resample();
+  if (0 < count) {
+    if (m_dumpFile.is_open()) {
+      m_dumpFile.write(reinterpret_cast<const char*>(m_resampled.data()), count * sizeof(gr_complex));
+    }
+    m_agc.scaleN(m_resampled.data(), m_resampled.data(), count);
+    m_converted.resize(count);
+    volk_32f_s32f_convert_8i(reinterpret_cast<int8_t*>(m_converted.data()), reinterpret_cast<const float*>(m_resampled.data()), 127.0f, 2 * count);
+    push(m_converted.data(), count, time);
+  }
+  logReaderStats();
+  return true;
 }
 
 Recording Recorder::getRecording() const { return m_recording; }
 
 void Recorder::flush() {
   m_lastDataTime = getTime();
-  m_buffer->popSingleSample([this](const SimpleComplex* data, const int size, const std::chrono::milliseconds& time) {
-    TransmissionQuery transmission(m_recording.source, m_recording.name, time, m_recording.recordingFrequency, m_recording.bandwidth, m_recording.modulation, encode_base64(data, size));
+  std::vector<SimpleComplex> samples;
+  std::vector<std::chrono::milliseconds> samplesTime;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto parts = static_cast<int>(m_samples.size()) / m_samplesSize;
+    samples.assign(m_samples.begin(), m_samples.begin() + parts * m_samplesSize);
+    samplesTime.assign(m_samplesTime.begin(), m_samplesTime.begin() + parts);
+    m_samples.erase(m_samples.begin(), m_samples.begin() + parts * m_samplesSize);
+    m_samplesTime.erase(m_samplesTime.begin(), m_samplesTime.begin() + parts);
+  }
+  for (size_t i = 0; i < samplesTime.size(); ++i) {
+    const auto data = samples.data() + i * m_samplesSize;
+    TransmissionQuery transmission(
+        m_recording.source, m_recording.name, samplesTime[i], m_recording.recordingFrequency, m_recording.bandwidth, m_recording.modulation, encode_base64(data, m_samplesSize));
     m_send(transmission);
-  });
+  }
 }
 
 std::chrono::milliseconds Recorder::getDuration() const { return m_lastDataTime - m_firstDataTime; }
+
+int Recorder::decimate() {
+  const auto ntaps = static_cast<int>(m_decimator.ntaps());
+  const auto available = static_cast<int>(m_input.size());
+  if (available < ntaps) {
+    return 0;
+  }
+  const auto count = (available - ntaps) / m_decim + 1;
+  const auto size = m_decimated.size();
+  m_decimated.resize(size + count);
+  m_decimator.filterNdec(m_decimated.data() + size, m_input.data(), count, m_decim);
+  m_input.erase(m_input.begin(), m_input.begin() + count * m_decim);
+  return count;
+}
+
+int Recorder::resample() {
+  // resampler may read up to 1 / rate samples more than requested, they have to be in buffer
+  const auto rate = getResamplerRate(m_sampleRate / m_decim, m_bandwidth);
+  const auto history = static_cast<int>(m_resampler.taps_per_filter()) - 1;
+  const auto margin = static_cast<int>(std::ceil(1.0 / rate));
+  const auto toRead = static_cast<int>(m_decimated.size()) - history - margin;
+  if (toRead <= 0) {
+    return 0;
+  }
+  m_resampled.resize((toRead + 1) * (static_cast<int>(std::ceil(rate)) + 1));
+  int read = 0;
+  const auto count = m_resampler.filter(m_resampled.data(), m_decimated.data(), toRead, read);
+  m_decimated.erase(m_decimated.begin(), m_decimated.begin() + std::min(read, static_cast<int>(m_decimated.size())));
+  return count;
+}
+
+void Recorder::push(const SimpleComplex* data, const int count, const std::chrono::nanoseconds time) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  int total = 0;
+  while (total < count) {
+    const auto offset = static_cast<int>(m_samples.size()) % m_samplesSize;
+    if (offset == 0) {
+      const auto sampleTime = time + std::chrono::nanoseconds(static_cast<int64_t>(1e9 * total / m_bandwidth));
+      m_samplesTime.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(sampleTime));
+    }
+    const auto size = std::min(count - total, m_samplesSize - offset);
+    m_samples.insert(m_samples.end(), data + total, data + total + size);
+    total += size;
+  }
+}
+
+void Recorder::logReaderStats() {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastStatsTime < READER_STATS_LOG_INTERVAL) {
+    return;
+  }
+  const auto lost = m_reader->lost();
+  if (m_lastLost < lost) {
+    Logger::warn(LABEL, "reader lag: {}, lost samples: {}", colored(RED, "{}", m_reader->lag()), colored(RED, "{}", lost - m_lastLost));
+  } else {
+    Logger::debug(LABEL, "reader lag: {}", colored(GREEN, "{}", m_reader->lag()));
+  }
+  m_lastStatsTime = now;
+  m_lastLost = lost;
+}
@@ -1,39 +1,86 @@
 #pragma once
 
 #include <config.h>
-#include <gnuradio/blocks/rotator_cc.h>
-#include <gnuradio/top_block.h>
-#include <radio/blocks/buffer.h>
-#include <radio/connector.h>
+#include <gnuradio/analog/agc2.h>
+#include <gnuradio/blocks/rotator.h>
+#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/filter/pfb_arb_resampler.h>
 #include <radio/help_structures.h>
+#include <radio/recorder_bank.h>
+#include <radio/stream_tags.h>
+#include <utils/broadcast_ring.h>
 #include <utils/utils.h>
 
-#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
+// recording chain without own flowgraph: shift with decimation, resampling to bandwidth, agc and conversion to 8 bit samples
+// recorder is prepared ahead, start attaches it to stream and hands it to bank thread, bank thread calls process
+// recorder is used for single recording with input rate and bandwidth given at build
 class Recorder {
  public:
   Recorder() = delete;
   Recorder(const Recorder&) = delete;
   Recorder& operator=(const Recorder&) = delete;
 
-  Recorder(const Config& config, const Device& device, const std::string& zeromq, Frequency sampleRate, const Recording& recording, std::function<void(const nlohmann::json&)> send);
+  Recorder(const Config& config, const Device& device, RecorderBank& bank, Frequency sampleRate, Frequency bandwidth);
   ~Recorder();
 
+  void start(
+      std::shared_ptr<BroadcastRing<gr_complex>> ring,
+      std::shared_ptr<TimeAnchor> timeAnchor,
+      Frequency shift,
+      const Recording& recording,
+      std::function<void(const nlohmann::json&)> send);
+  // processes single slice of stream, false if there were no new samples
+  bool process();
+
   Recording getRecording() const;
   void flush();
   std::chrono::milliseconds getDuration() const;
 
  private:
+  int decimate();
+  int resample();
+  void push(const SimpleComplex* data, const int count, const std::chrono::nanoseconds time);
+  void logReaderStats();
+
   const Config& m_config;
+  const Device m_device;
+  RecorderBank& m_bank;
   const Frequency m_sampleRate;
-  const Recording m_recording;
-  const std::function<void(const nlohmann::json&)> m_send;
+  const Frequency m_bandwidth;
+  const int m_decim;
+  const int m_samplesSize;
+  Recording m_recording;
+  std::function<void(const nlohmann::json&)> m_send;
+
+  std::unique_ptr<BroadcastRing<gr_complex>::Reader> m_reader;
+  std::shared_ptr<TimeAnchor> m_timeAnchor;
+  gr::blocks::rotator m_rotator;
+  gr::filter::kernel::fir_filter_ccf m_decimator;
+  gr::filter::kernel::pfb_arb_resampler_ccf m_resampler;
+  gr::analog::kernel::agc2_cc m_agc;
+  // filter inputs keep history needed by next outputs
+  std::vector<gr_complex> m_input;
+  std::vector<gr_complex> m_decimated;
+  std::vector<gr_complex> m_resampled;
+  std::vector<SimpleComplex> m_converted;
+  std::ofstream m_dumpFile;
+
+  // samples are sent in parts of samplesSize, every part has time of its first sample
+  std::mutex m_mutex;
+  std::vector<SimpleComplex> m_samples;
+  std::vector<std::chrono::milliseconds> m_samplesTime;
 
-  std::shared_ptr<gr::top_block> m_tb;
-  std::shared_ptr<Buffer<SimpleComplex>> m_buffer;
-  Connector m_connector;
   std::chrono::milliseconds m_firstDataTime;
   std::chrono::milliseconds m_lastDataTime;
+  std::chrono::steady_clock::time_point m_lastStatsTime;
+  uint64_t m_lastLost;
+  bool m_isStarted;
+  bool m_isFirstSlice;
 };
@@ -0,0 +1,96 @@
+#include "recorder_bank.h"
+
+#include <logger.h>
+#include <radio/recorder.h>
+
+#include <algorithm>
+#include <limits>
+
+constexpr auto LABEL = "recorder";
+
+RecorderBank::RecorderBank(const int threads) : m_isRunning(true) {
+  for (int i = 0; i < std::max(1, threads); ++i) {
+    m_workers.push_back(std::make_unique<Worker>());
+  }
+  for (auto& worker : m_workers) {
+    worker->thread = std::thread([this, &worker]() { work(*worker); });
+  }
+  Logger::info(LABEL, "recorder threads: {}", colored(GREEN, "{}", m_workers.size()));
+}
+
+RecorderBank::~RecorderBank() {
+  m_isRunning = false;
+  for (auto& worker : m_workers) {
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      worker->condition.notify_one();
+    }
+    worker->thread.join();
+  }
+}
+
+void RecorderBank::add(Recorder* recorder) {
+  size_t index = 0;
+  size_t minCount = std::numeric_limits<size_t>::max();
+  for (size_t i = 0; i < m_workers.size(); ++i) {
+    std::lock_guard<std::mutex> lock(m_workers[i]->mutex);
+    if (m_workers[i]->recorders.size() < minCount) {
+      minCount = m_workers[i]->recorders.size();
+      index = i;
+    }
+  }
+  auto& worker = *m_workers[index];
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  worker.recorders.push_back(recorder);
+  worker.isNotified = true;
+  worker.condition.notify_one();
+}
+
+void RecorderBank::remove(Recorder* recorder) {
+  for (auto& worker : m_workers) {
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      if (std::erase(worker->recorders, recorder) == 0) {
+        continue;
+      }
+    }
+    // pass that copied list before recorder was erased has to finish
+    std::lock_guard<std::mutex> lock(worker->processMutex);
+  }
+}
+
+void RecorderBank::notify() {
+  for (auto& worker : m_workers) {
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    if (!worker->recorders.empty()) {
+      worker->isNotified = true;
+      worker->condition.notify_one();
+    }
+  }
+}
+
+void RecorderBank::work(Worker& worker) {
+  std::vector<Recorder*> recorders;
+  bool isProcessed = false;
+  while (true) {
+    {
+      // pass is repeated without waiting while recorders still have samples
+      std::unique_lock<std::mutex> lock(worker.mutex);
+      worker.condition.wait(lock, [this, &worker, isProcessed]() { return !m_isRunning || (!worker.recorders.empty() && (isProcessed || worker.isNotified)); });
+      if (!m_isRunning) {
+        return;
+      }
+    }
+    std::lock_guard<std::mutex> processLock(worker.processMutex);
+    {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      recorders = worker.recorders;
+      worker.isNotified = false;
+    }
+    // every recorder processes one part of its samples per pass, so long backlog of one recording does not delay others
+    isProcessed = false;
+    for (auto* recorder : recorders) {
+      isProcessed |= recorder->process();
+    }
+  }
+}
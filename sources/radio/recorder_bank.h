@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Recorder;
+
+// fixed number of threads process all recordings of device, thread count does not depend on number of recordings
+// started recorder is assigned to least loaded thread and stays there until it is removed
+// thread without recorders is parked, thread with recorders sleeps until stream writer notifies about new samples
+class RecorderBank {
+ public:
+  RecorderBank(int threads);
+  RecorderBank(const RecorderBank&) = delete;
+  RecorderBank& operator=(const RecorderBank&) = delete;
+  ~RecorderBank();
+
+  void add(Recorder* recorder);
+  // returns after thread finished processing recorder
+  void remove(Recorder* recorder);
+  // called by stream writer after new samples were written
+  void notify();
+
+ private:
+  struct Worker {
+    // recorders list is changed under mutex, pass over copy of list runs under process mutex
+    std::mutex mutex;
+    std::mutex processMutex;
+    std::condition_variable condition;
+    std::vector<Recorder*> recorders;
+    bool isNotified = false;
+    std::thread thread;
+  };
+
+  void work(Worker& worker);
+
+  std::atomic<bool> m_isRunning;
+  std::vector<std::unique_ptr<Worker>> m_workers;
+};
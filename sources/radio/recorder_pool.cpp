@@ -0,0 +1,65 @@
+#include "recorder_pool.h"
+
+#include <logger.h>
+
+constexpr auto LABEL = "recorder";
+
+RecorderPool::RecorderPool(const Config& config, const Device& device, RecorderBank& bank, Frequency sampleRate, Frequency bandwidth, int size)
+    : m_config(config), m_device(device), m_bank(bank), m_sampleRate(sampleRate), m_bandwidth(bandwidth), m_size(std::max(0, size)), m_isRunning(true), m_thread([this]() { worker(); }) {
+  Logger::info(LABEL, "recorder pool, size: {}, sample rate: {}, bandwidth: {}", colored(GREEN, "{}", m_size), formatFrequency(m_sampleRate), formatFrequency(m_bandwidth));
+}
+
+RecorderPool::~RecorderPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isRunning = false;
+  }
+  m_condition.notify_all();
+  m_thread.join();
+}
+
+std::unique_ptr<Recorder> RecorderPool::acquire(Frequency bandwidth) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (bandwidth == m_bandwidth && !m_idle.empty()) {
+      auto recorder = std::move(m_idle.back());
+      m_idle.pop_back();
+      m_condition.notify_all();
+      return recorder;
+    }
+  }
+  Logger::debug(LABEL, "no prepared recorder, bandwidth: {}", formatFrequency(bandwidth, YELLOW));
+  return std::make_unique<Recorder>(m_config, m_device, m_bank, m_sampleRate, bandwidth);
+}
+
+void RecorderPool::release(std::unique_ptr<Recorder> recorder) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_released.push_back(std::move(recorder));
+  }
+  m_condition.notify_all();
+}
+
+void RecorderPool::worker() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (m_isRunning) {
+    m_condition.wait(lock, [this]() { return !m_isRunning || !m_released.empty() || m_idle.size() < m_size; });
+    if (!m_isRunning) {
+      break;
+    }
+    // recorders are destroyed and built without lock, scanner thread can acquire meanwhile
+    auto released = std::move(m_released);
+    m_released.clear();
+    const auto isMissing = m_idle.size() < m_size;
+    lock.unlock();
+    released.clear();
+    std::unique_ptr<Recorder> recorder;
+    if (isMissing) {
+      recorder = std::make_unique<Recorder>(m_config, m_device, m_bank, m_sampleRate, m_bandwidth);
+    }
+    lock.lock();
+    if (recorder) {
+      m_idle.push_back(std::move(recorder));
+    }
+  }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <config.h>
+#include <radio/help_structures.h>
+#include <radio/recorder.h>
+#include <radio/recorder_bank.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// keeps idle recorders prepared by background thread, so starting recording does not wait for filters setup
+// released recorders are destroyed by background thread too, because removing them from bank waits for bank thread
+class RecorderPool {
+ public:
+  RecorderPool(const Config& config, const Device& device, RecorderBank& bank, Frequency sampleRate, Frequency bandwidth, int size);
+  RecorderPool(const RecorderPool&) = delete;
+  RecorderPool& operator=(const RecorderPool&) = delete;
+  ~RecorderPool();
+
+  // recording with other bandwidth than pool gets recorder built synchronously
+  std::unique_ptr<Recorder> acquire(Frequency bandwidth);
+  void release(std::unique_ptr<Recorder> recorder);
+
+ private:
+  void worker();
+
+  const Config& m_config;
+  const Device m_device;
+  RecorderBank& m_bank;
+  const Frequency m_sampleRate;
+  const Frequency m_bandwidth;
+  const size_t m_size;
+  std::vector<std::unique_ptr<Recorder>> m_idle;
+  std::vector<std::unique_ptr<Recorder>> m_released;
+  bool m_isRunning;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::thread m_thread;
+};
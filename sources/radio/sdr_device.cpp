@@ -2,51 +2,128 @@
 
 #include <config.h>
 #include <gnuradio/block_detail.h>
-#include <gnuradio/blocks/copy.h>
 #include <gnuradio/blocks/file_sink.h>
-#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/stream_to_streams.h>
+#include <gnuradio/filter/firdes.h>
+#include <gnuradio/filter/pfb_channelizer_ccf.h>
 #include <gnuradio/soapy/source.h>
-#include <gnuradio/zeromq/pub_sink.h>
 #include <logger.h>
 #include <network/remote_controller.h>
 #include <notification.h>
+#include <radio/blocks/broadcast_sink.h>
+#include <radio/blocks/file_source.h>
 #include <radio/blocks/sdr_source.h>
+#include <radio/blocks/shared_ring_sink.h>
+#include <radio/blocks/stream_gate.h>
 #include <radio/help_structures.h>
 #include <radio/recorder.h>
+#include <radio/recorder_bank.h>
+#include <radio/recorder_pool.h>
 #include <radio/sdr_processor.h>
-
-#include <filesystem>
+#include <utils/file_utils.h>
 
 constexpr auto LABEL = "sdr";
 
+std::string getSettleFileName(const Config& config) { return fmt::format("{}/retune_settle.json", config.workDir()); }
+
+SettleEstimator buildSettleEstimator(const Config& config, const Device& device) {
+  const auto blocks = static_cast<int>(device.sample_rate * std::chrono::duration<double>(RETUNE_SETTLE_MEASURE_TIME).count() / RETUNE_SETTLE_BLOCK_SIZE);
+  auto settleSamples = static_cast<int>(device.sample_rate * std::chrono::duration<double>(RETUNE_SETTLE_DEFAULT_TIME).count());
+  const auto json = readFromFile(getSettleFileName(config), nlohmann::json::object());
+  if (json.contains(device.getName()) && json.at(device.getName()).value("sample_rate", 0) == device.sample_rate) {
+    settleSamples = json.at(device.getName()).value("settle_samples", settleSamples);
+  }
+  Logger::info(LABEL, "retune settle samples: {}", colored(GREEN, "{}", settleSamples));
+  return {RETUNE_SETTLE_BLOCK_SIZE, blocks, settleSamples};
+}
+
+void saveSettleSamples(const Config& config, const Device& device, const int settleSamples) {
+  auto json = readFromFile(getSettleFileName(config), nlohmann::json::object());
+  json[device.getName()] = {{"sample_rate", device.sample_rate}, {"settle_samples", settleSamples}};
+  saveToFile(getSettleFileName(config), json);
+}
+
+std::vector<Broadcast> buildBroadcasts(const Device& device, const ChannelMap& channelMap) {
+  // single full rate stream without channelizer
+  const auto count = std::max(1, channelMap.count());
+  const auto rate = channelMap.count() == 0 ? device.sample_rate : channelMap.rate();
+  const auto capacity = static_cast<size_t>(rate * std::chrono::duration<double>(RECORDER_RING_BUFFER_TIME).count());
+  std::vector<Broadcast> broadcasts;
+  for (int i = 0; i < count; ++i) {
+    broadcasts.push_back({std::make_shared<BroadcastRing<gr_complex>>(capacity), std::make_shared<TimeAnchor>(rate)});
+  }
+  return broadcasts;
+}
+
+std::shared_ptr<Source> buildSource(const Config& config, const Device& device) {
+  if (config.replayDir().empty()) {
+    return std::make_shared<SdrSource>(device);
+  } else {
+    return std::make_shared<FileSource>(config, device);
+  }
+}
+
 SdrDevice::SdrDevice(const Config& config, const Device& device, RemoteController& remoteController, TransmissionNotification& notification, const std::vector<FrequencyRange>& ranges)
     : m_config(config),
       m_device(device),
-      m_zeromq(fmt::format("ipc://{}/{}_{}_zeromq_stream.sock", std::filesystem::canonical(m_config.workDir()).string(), device.driver, device.serial)),
+      m_channelMap(device.sample_rate, RECORDER_CHANNEL_SPACING, config.recordingBandwidth()),
+      m_broadcasts(buildBroadcasts(device, m_channelMap)),
       m_remoteController(remoteController),
       m_notification(notification),
       m_isInitialized(false),
+      m_settleEstimator(buildSettleEstimator(config, device)),
       m_tb(gr::make_top_block("device")),
-      m_source(std::make_shared<SdrSource>(device)),
-      m_selector(gr::blocks::selector::make(sizeof(gr_complex), 0, 0)),
+      m_source(buildSource(config, device)),
       m_connector(m_tb) {
   Logger::info(LABEL, "starting");
   Logger::info(LABEL, "driver: {}, serial: {}, sample rate: {}", colored(GREEN, "{}", device.driver), colored(GREEN, "{}", device.serial), formatFrequency(device.sample_rate));
-  Logger::info(LABEL, "zeromq: {}", colored(GREEN, "{}", m_zeromq));
-
-  m_connector.connect<Block>(m_source, gr::zeromq::pub_sink::make(sizeof(gr_complex), 1, const_cast<char*>(m_zeromq.c_str())));
-  m_connector.connect<Block>(m_source, m_selector, gr::blocks::null_sink::make(sizeof(gr_complex)));
-
-  int index = 1;
-  for (const auto& range : ranges) {
-    Logger::info(LABEL, "creating processor, index: {}, range: {}", index, formatFrequencyRange(range, GREEN));
-    auto forward = gr::blocks::copy::make(sizeof(gr_complex));
-    auto processor = std::make_unique<SdrProcessor>(m_config, m_device, m_remoteController, m_notification, forward, m_connector, range);
-    m_connector.connect(m_selector, forward, index, 0);
-    m_processors.push_back(std::move(processor));
-    m_processorIndex[range.center()] = index++;
+
+  // all recordings share few threads of bank, their count does not depend on recorders limit
+  m_recorderBank = std::make_unique<RecorderBank>(RECORDER_THREADS);
+  const auto notify = [this]() { m_recorderBank->notify(); };
+  if (m_channelMap.count() == 0) {
+    m_connector.connect<Block>(m_source, std::make_shared<BroadcastSink>(m_broadcasts, device.sample_rate, notify));
+  } else {
+    // band is split once for all recorders, passband covers half of spacing plus recording and stopband starts where aliases would reach it
+    const auto count = m_channelMap.count();
+    const auto spacing = m_channelMap.spacing();
+    const auto bandwidth = config.recordingBandwidth();
+    Logger::info(LABEL, "recorder channels: {}, spacing: {}, channel rate: {}", colored(GREEN, "{}", count), formatFrequency(static_cast<Frequency>(spacing)), formatFrequency(m_channelMap.rate()));
+    const auto taps = gr::filter::firdes::low_pass(1.0, device.sample_rate, spacing, spacing - bandwidth, gr::fft::window::WIN_BLACKMAN_HARRIS);
+    // channelizer works only while any recorder reads its channels, first recorder gets channel history from gate
+    const auto history = static_cast<int>(device.sample_rate * std::chrono::duration<double>(RECORDER_HISTORY_TIME).count());
+    const auto gate = std::make_shared<StreamGate>(device.sample_rate, history, [this]() {
+      return std::any_of(m_broadcasts.begin(), m_broadcasts.end(), [](const Broadcast& broadcast) { return broadcast.ring->hasReaders(); });
+    });
+    const auto splitter = gr::blocks::stream_to_streams::make(sizeof(gr_complex), count);
+    const auto channelizer = gr::filter::pfb_channelizer_ccf::make(count, taps, 2.0f);
+    const auto sink = std::make_shared<BroadcastSink>(m_broadcasts, m_channelMap.rate(), notify);
+    m_connector.connect<Block>(m_source, gate, splitter);
+    for (int i = 0; i < count; ++i) {
+      m_connector.connect(splitter, channelizer, i, i);
+      m_connector.connect(channelizer, sink, i, i);
+    }
+  }
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    Logger::info(LABEL, "scanning range, index: {}, range: {}", i, formatFrequencyRange(ranges[i], GREEN));
+  }
+  m_processor = std::make_unique<SdrProcessor>(m_config, m_device, m_remoteController, m_notification, m_settleEstimator, m_source, m_connector, ranges);
+  const auto recorderRate = m_channelMap.count() == 0 ? device.sample_rate : m_channelMap.rate();
+  m_recorderPool = std::make_unique<RecorderPool>(config, device, *m_recorderBank, recorderRate, config.recordingBandwidth(), std::min(RECORDER_POOL_SIZE, config.recordersCount()));
+
+  if (config.sharedRingExport()) {
+    // export is optional, scanning continues without it
+    try {
+      const auto name = fmt::format("/sdr_scanner_{}", device.getName());
+      const auto capacity = static_cast<uint64_t>(device.sample_rate * std::chrono::duration<double>(SHARED_RING_BUFFER_TIME).count());
+      m_connector.connect<Block>(m_source, std::make_shared<SharedRingSink>(name, capacity, device.sample_rate));
+      Logger::info(LABEL, "shared ring: {}", colored(GREEN, "/dev/shm{}", name));
+    } catch (const std::runtime_error& exception) {
+      Logger::exception(LABEL, exception, SPDLOG_LOC, "shared ring export failed");
+    }
   }
 
+  // continuous dump of all frequencies for inspection, replay uses per range dumps written by processor
   if (config.dumpSource()) {
     const auto fileName = getRawFileName(config.workDir(), device, "source-all", "fc", ranges.front().center(), device.sample_rate);
     m_connector.connect<Block>(m_source, gr::blocks::file_sink::make(sizeof(gr_complex), fileName.c_str()));
@@ -57,9 +134,13 @@ SdrDevice::SdrDevice(const Config& config, const Device& device, RemoteControlle
 }
 
 SdrDevice::~SdrDevice() {
+  // flowgraph notifies bank, it is stopped first
   m_tb->stop();
   m_tb->wait();
-  std::remove(m_zeromq.c_str());
+  m_recorders.clear();
+  m_recorderPool.reset();
+  m_recorderBank.reset();
+  saveSettleSamples(m_config, m_device, m_settleEstimator.getSettleSamples());
   Logger::info(LABEL, "stopped");
 }
 
@@ -71,36 +152,37 @@ void SdrDevice::setFrequencyRange(FrequencyRange frequencyRange) {
     m_isInitialized = true;
   }
 
-  m_selector->set_output_index(0);
+  // processor drops samples until retune tag with range frequency and settle samples, other ranges are dropped entirely
   const auto frequency = frequencyRange.center();
   if (m_source->setCenterFrequency(frequency)) {
     Logger::debug(LABEL, "set frequency range: {}, center frequency: {}", formatFrequencyRange(frequencyRange), formatFrequency(frequency));
   } else {
     Logger::warn(LABEL, "set frequency range failed: {}, center frequency: {}", formatFrequencyRange(frequencyRange), formatFrequency(frequency));
   }
-  std::this_thread::sleep_for(std::chrono::milliseconds(1));
-  auto it = m_processorIndex.find(frequencyRange.center());
-  if (it != m_processorIndex.end()) {
-    m_selector->set_output_index(it->second);
-  }
 }
 
-void SdrDevice::updateRecordings(const std::vector<Recording> recordings) {
+void SdrDevice::updateRecordings(const std::vector<Recording>& recordings) {
   const auto findRecorder = [this](const Recording& recording) {
-    return std::find_if(m_recorders.begin(), m_recorders.end(), [recording](const std::unique_ptr<Recorder>& recorder) {
+    return std::find_if(m_recorders.begin(), m_recorders.end(), [&recording](const std::unique_ptr<Recorder>& recorder) {
       // improve auto formatter
       return recording.recordingFrequency == recorder->getRecording().recordingFrequency;
     });
   };
 
-  const auto isRecordingActive = [recordings](const Recording& recording1) {
-    return std::find_if(recordings.begin(), recordings.end(), [recording1](const Recording& recording2) {
+  const auto isRecordingActive = [&recordings](const Recording& recording1) {
+    return std::find_if(recordings.begin(), recordings.end(), [&recording1](const Recording& recording2) {
              // improve auto formatter
              return recording1.recordingFrequency == recording2.recordingFrequency;
            }) != recordings.end();
   };
 
-  std::erase_if(m_recorders, [isRecordingActive](const std::unique_ptr<Recorder>& recorder) { return !isRecordingActive(recorder->getRecording()); });
+  // finished recorders are stopped by pool thread
+  for (auto& recorder : m_recorders) {
+    if (!isRecordingActive(recorder->getRecording())) {
+      m_recorderPool->release(std::move(recorder));
+    }
+  }
+  std::erase(m_recorders, nullptr);
 
   if (m_recorders.size() < static_cast<size_t>(m_config.recordersCount())) {
     ignoredTransmissions.clear();
@@ -114,9 +196,19 @@ void SdrDevice::updateRecordings(const std::vector<Recording> recordings) {
       }
     } else {
       if (m_recorders.size() < static_cast<size_t>(m_config.recordersCount())) {
-        const auto sampleRate = m_device.sample_rate;
-        m_recorders.push_back(
-            std::make_unique<Recorder>(m_config, m_device, m_zeromq, sampleRate, recording, std::bind(&RemoteController::sendTransmission, m_remoteController, m_device, std::placeholders::_1)));
+        const auto send = std::bind(&RemoteController::sendTransmission, m_remoteController, m_device, std::placeholders::_1);
+        auto recorder = m_recorderPool->acquire(recording.bandwidth);
+        if (m_channelMap.count() == 0) {
+          const auto& broadcast = m_broadcasts.front();
+          recorder->start(broadcast.ring, broadcast.timeAnchor, recording.shift(), recording, send);
+        } else {
+          const auto channel = m_channelMap.getChannel(recording.shift());
+          const auto residual = m_channelMap.getResidual(recording.shift());
+          Logger::debug(LABEL, "recording: {}, channel: {}, residual: {}", formatFrequency(recording.recordingFrequency), channel, formatFrequency(residual));
+          const auto& broadcast = m_broadcasts[channel];
+          recorder->start(broadcast.ring, broadcast.timeAnchor, residual, recording, send);
+        }
+        m_recorders.push_back(std::move(recorder));
       } else {
         if (!ignoredTransmissions.count(recording.recordingFrequency)) {
           Logger::info(LABEL, "maximum recorders limit reached, frequency: {}", formatFrequency(recording.recordingFrequency, RED));
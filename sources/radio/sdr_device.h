@@ -1,13 +1,19 @@
 #pragma once
 
-#include <gnuradio/blocks/selector.h>
 #include <gnuradio/top_block.h>
 #include <network/remote_controller.h>
 #include <notification.h>
-#include <radio/blocks/sdr_source.h>
+#include <radio/blocks/broadcast_sink.h>
+#include <radio/blocks/source.h>
+#include <radio/channel_map.h>
 #include <radio/help_structures.h>
 #include <radio/recorder.h>
+#include <radio/recorder_bank.h>
+#include <radio/recorder_pool.h>
 #include <radio/sdr_processor.h>
+#include <radio/settle_estimator.h>
+#include <radio/stream_tags.h>
+#include <utils/broadcast_ring.h>
 
 #include <memory>
 #include <set>
@@ -19,22 +25,24 @@ class SdrDevice {
   ~SdrDevice();
 
   void setFrequencyRange(FrequencyRange frequencyRange);
-  void updateRecordings(const std::vector<Recording> recordings);
+  void updateRecordings(const std::vector<Recording>& recordings);
 
  private:
   const Config& m_config;
   const Device m_device;
-  const std::string m_zeromq;
+  const ChannelMap m_channelMap;
+  const std::vector<Broadcast> m_broadcasts;
   RemoteController& m_remoteController;
   TransmissionNotification& m_notification;
   bool m_isInitialized;
+  SettleEstimator m_settleEstimator;
 
   std::shared_ptr<gr::top_block> m_tb;
-  std::shared_ptr<SdrSource> m_source;
-  std::shared_ptr<gr::blocks::selector> m_selector;
+  std::shared_ptr<Source> m_source;
   Connector m_connector;
-  std::vector<std::unique_ptr<SdrProcessor>> m_processors;
-  std::map<Frequency, int> m_processorIndex;
+  std::unique_ptr<SdrProcessor> m_processor;
+  std::unique_ptr<RecorderBank> m_recorderBank;
+  std::unique_ptr<RecorderPool> m_recorderPool;
   std::vector<std::unique_ptr<Recorder>> m_recorders;
   std::set<Frequency> ignoredTransmissions;
 };
@@ -89,6 +89,8 @@ Device SdrDeviceReader::createDevice(const SoapySDR::Kwargs args) {
   device.enabled = true;
   device.start_recording_level = DEFAULT_RECORDING_START_LEVEL;
   device.stop_recording_level = DEFAULT_RECORDING_STOP_LEVEL;
+  device.grouping_x = DEFAULT_GROUPING_X;
+  device.grouping_y = DEFAULT_GROUPING_Y;
   device.sample_rates = getSampleRates(sdr);
   device.gains = getGains(sdr);
 
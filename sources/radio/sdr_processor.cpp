@@ -1,19 +1,22 @@
 #include "sdr_processor.h"
 
-#include <gnuradio/blocks/file_sink.h>
 #include <gnuradio/blocks/float_to_char.h>
-#include <gnuradio/blocks/stream_to_vector.h>
-#include <gnuradio/fft/fft_v.h>
-#include <gnuradio/fft/window.h>
 #include <network/query.h>
-#include <radio/blocks/decimator.h>
+#include <radio/blocks/batch_fft.h>
+#include <radio/blocks/detector.h>
+#include <radio/blocks/frame_picker.h>
 #include <radio/blocks/noise_learner.h>
+#include <radio/blocks/power_averager.h>
 #include <radio/blocks/psd.h>
+#include <radio/blocks/range_dump_sink.h>
 #include <radio/blocks/spectrogram.h>
 #include <radio/blocks/transmission.h>
+#include <radio/blocks/zoom_fft.h>
 #include <utils/radio_utils.h>
 #include <utils/utils.h>
 
+#include <thread>
+
 constexpr auto LABEL = "processor";
 
 SdrProcessor::SdrProcessor(
@@ -21,11 +24,11 @@ SdrProcessor::SdrProcessor(
     const Device& device,
     RemoteController& remoteController,
     TransmissionNotification& notification,
+    SettleEstimator& settleEstimator,
     std::shared_ptr<gr::block> source,
     Connector& connector,
-    const FrequencyRange& frequencyRange)
+    const std::vector<FrequencyRange>& ranges)
     : m_connector(connector) {
-  const auto getFrequency = [frequencyRange]() { return frequencyRange.center(); };
   const auto sampleRate = device.sample_rate;
   const auto sendSpectrogram = [&remoteController, device, sampleRate](const std::chrono::milliseconds& time, const Frequency& frequency, const std::vector<int8_t>& data) {
     SpectrogramQuery spectrogram(device.alias.empty() ? SCANNER_SOURCE_NAME : GAIN_TESTER_SOURCE_NAME, time, frequency, sampleRate, encode_base64(data.data(), data.size()));
@@ -33,28 +36,60 @@ SdrProcessor::SdrProcessor(
   };
 
   const auto fftSize = getFft(sampleRate, SIGNAL_DETECTION_MAX_STEP);
-  const auto step = static_cast<double>(sampleRate) / fftSize;
-  const auto indexStep = static_cast<Frequency>(std::ceil(config.recordingBandwidth() / (static_cast<double>(sampleRate) / fftSize)));
-  const auto decimatorFactor = std::max(1, static_cast<int>(step / SIGNAL_DETECTION_FPS));
-  const auto indexToFrequency = [sampleRate, frequencyRange, step](const int index) { return frequencyRange.center() + static_cast<Frequency>(step * (index + 0.5)) - sampleRate / 2; };
+  const auto decimatorFactor = std::max(1, static_cast<int>(static_cast<double>(sampleRate) / fftSize / SIGNAL_DETECTION_FPS));
+  // zoom detection runs on coarse spectrum of full resolution frames, fine resolution is computed only around detected signals
+  const auto isZoom = device.zoom_detection;
+  const auto detectionSize = isZoom ? std::min(fftSize, getFft(sampleRate, ZOOM_COARSE_MAX_STEP)) : fftSize;
+  const auto step = static_cast<double>(sampleRate) / detectionSize;
+  const auto indexStep = static_cast<Frequency>(std::ceil(config.recordingBandwidth() / step));
+  // overlap is used only when every frame is processed, averaging processes every frame and sums power of frames within one detection tick
+  const auto overlap = std::clamp(device.frame_overlap, 0.0, 0.9);
+  const auto isAveraging = device.frame_averaging && 1 < decimatorFactor && !isZoom;
+  const auto frameStep = decimatorFactor == 1 || isAveraging ? static_cast<int>(fftSize * (1.0 - overlap)) : fftSize * decimatorFactor;
+  const auto averageFactor = isAveraging ? std::max(1, static_cast<int>(static_cast<double>(sampleRate) / frameStep / SIGNAL_DETECTION_FPS)) : 1;
+  const auto frameRate = static_cast<double>(sampleRate) / frameStep / averageFactor;
+  const auto indexToFrequency = [sampleRate, step](const Frequency center, const int index) { return center + static_cast<Frequency>(step * (index + 0.5)) - sampleRate / 2; };
   const auto indexToShift = [sampleRate, step](const int index) { return static_cast<Frequency>(step * (index + 0.5)) - sampleRate / 2; };
-  const auto isIndexInRange = [frequencyRange, indexToFrequency](const int index) { return frequencyRange.contains(indexToFrequency(index)); };
-  Logger::info(LABEL, "signal detection, fft: {}, step: {}, decimator factor: {}", colored(GREEN, "{}", fftSize), formatFrequency(step), colored(GREEN, "{}", decimatorFactor));
-
-  const auto s2c = gr::blocks::stream_to_vector::make(sizeof(gr_complex), fftSize * decimatorFactor);
-  const auto decimator = std::make_shared<Decimator<gr_complex>>(fftSize, decimatorFactor);
-  const auto fft = gr::fft::fft_v<gr_complex, true>::make(fftSize, gr::fft::window::hamming(fftSize), true);
-  const auto psd = std::make_shared<PSD>(fftSize, sampleRate);
-  const auto noiseLearner = std::make_shared<NoiseLearner>(fftSize, getFrequency, indexToFrequency);
-  const auto transmission = std::make_shared<Transmission>(config, device, fftSize, indexStep, notification, getFrequency, indexToFrequency, indexToShift, isIndexInRange);
-  m_connector.connect<Block>(source, s2c, decimator, fft, psd, noiseLearner, transmission);
+  Logger::info(
+      LABEL,
+      "signal detection, fft: {}, detection fft: {}, step: {}, decimator factor: {}, frame step: {}, average factor: {}",
+      colored(GREEN, "{}", fftSize),
+      colored(GREEN, "{}", detectionSize),
+      formatFrequency(step),
+      colored(GREEN, "{}", decimatorFactor),
+      colored(GREEN, "{}", frameStep),
+      colored(GREEN, "{}", averageFactor));
 
-  const auto spectrogram = std::make_shared<Spectrogram>(fftSize, sampleRate, getFrequency, sendSpectrogram);
-  m_connector.connect<Block>(psd, spectrogram);
+  const auto framePicker = std::make_shared<FramePicker>(fftSize, frameStep, sampleRate, ranges, settleEstimator);
+  const auto zoomTable = isZoom ? std::make_shared<ZoomTable>(ranges.size()) : nullptr;
+  const auto noiseLearner = std::make_shared<NoiseLearner>(detectionSize, ranges, indexToFrequency);
+  const auto transmission = std::make_shared<Transmission>(config, device, detectionSize, indexStep, fftSize / detectionSize, frameRate, ranges, notification, indexToFrequency, indexToShift, zoomTable);
+  const auto spectrogram = std::make_shared<Spectrogram>(detectionSize, sampleRate, frameRate, ranges, sendSpectrogram);
+  // batching matters when frames are queued (overlap, averaging), threads only for long transforms
+  const auto fftThreads = 0 < device.fft_threads ? device.fft_threads : getFftThreads(fftSize, static_cast<int>(std::thread::hardware_concurrency()));
+  const auto fft = isZoom ? nullptr : std::make_shared<BatchFft>(config, fftSize, getFftBatch(fftSize), fftThreads);
+  if (isZoom) {
+    // zoom fft replaces full resolution fft and power stage
+    const auto zoomFft = std::make_shared<ZoomFft>(fftSize, detectionSize, sampleRate, zoomTable, indexToShift);
+    m_connector.connect<Block>(source, framePicker, zoomFft, noiseLearner, transmission);
+    m_connector.connect<Block>(zoomFft, spectrogram);
+  } else if (isAveraging) {
+    // averager already gives power in decibels with detection rate, remaining stages are cheap enough to stay separated
+    const auto averager = std::make_shared<PowerAverager>(fftSize, averageFactor, sampleRate, frameRate * averageFactor);
+    m_connector.connect<Block>(source, framePicker, fft, averager, noiseLearner, transmission);
+    m_connector.connect<Block>(averager, spectrogram);
+  } else if (config.stagedDetection()) {
+    const auto psd = std::make_shared<PSD>(fftSize, sampleRate);
+    m_connector.connect<Block>(source, framePicker, fft, psd, noiseLearner, transmission);
+    m_connector.connect<Block>(psd, spectrogram);
+  } else {
+    // noise learner and transmission are not connected, detector calls them directly
+    const auto detector = std::make_shared<Detector>(fftSize, sampleRate, frameRate, noiseLearner, transmission);
+    m_connector.connect<Block>(source, framePicker, fft, detector, spectrogram);
+  }
 
   if (config.dumpSource()) {
-    const auto fileName = getRawFileName(config.workDir(), device, "source", "fc", frequencyRange.center(), device.sample_rate);
-    m_connector.connect<Block>(source, gr::blocks::file_sink::make(sizeof(gr_complex), fileName.c_str()));
+    m_connector.connect<Block>(source, std::make_shared<RangeDumpSink>(config, device, ranges));
   }
 }
 
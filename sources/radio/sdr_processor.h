@@ -5,8 +5,10 @@
 #include <network/remote_controller.h>
 #include <radio/connector.h>
 #include <radio/help_structures.h>
+#include <radio/settle_estimator.h>
 
 #include <memory>
+#include <vector>
 
 class SdrProcessor {
  public:
@@ -15,9 +17,10 @@ class SdrProcessor {
       const Device& device,
       RemoteController& remoteController,
       TransmissionNotification& notification,
+      SettleEstimator& settleEstimator,
       std::shared_ptr<gr::block> source,
       Connector& connector,
-      const FrequencyRange& frequencyRange);
+      const std::vector<FrequencyRange>& ranges);
   ~SdrProcessor();
 
  private:
@@ -0,0 +1,47 @@
+#include "settle_estimator.h"
+
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+
+SettleEstimator::SettleEstimator(const int blockSize, const int blocks, const int settleSamples) : m_blockSize(blockSize), m_blocks(blocks), m_settleSamples(settleSamples) {}
+
+int SettleEstimator::getBlockSize() const { return m_blockSize; }
+
+int SettleEstimator::getBlocks() const { return m_blocks; }
+
+int SettleEstimator::getSettleSamples() const { return m_settleSamples; }
+
+void SettleEstimator::addMeasurement(const std::vector<float>& powers) {
+  const auto settleBlock = findSettleBlock(powers);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_measurements.push_back(settleBlock);
+  if (RETUNE_SETTLE_MEASUREMENTS < static_cast<int>(m_measurements.size())) {
+    m_measurements.pop_front();
+  }
+  // single transmission starting right after retune looks like transient, median ignores it
+  std::vector<int> sorted(m_measurements.begin(), m_measurements.end());
+  std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+  m_settleSamples = sorted[sorted.size() / 2] * m_blockSize;
+}
+
+int SettleEstimator::findSettleBlock(const std::vector<float>& powers) {
+  if (powers.size() < 2) {
+    return 0;
+  }
+
+  // second half of measurement is stable level, transient is searched only in first half
+  const auto half = powers.size() / 2;
+  std::vector<float> stable(powers.begin() + half, powers.end());
+  std::nth_element(stable.begin(), stable.begin() + stable.size() / 2, stable.end());
+  const auto level = stable[stable.size() / 2];
+
+  for (int i = half - 1; 0 <= i; --i) {
+    if (RETUNE_SETTLE_TOLERANCE < std::abs(powers[i] - level)) {
+      return i + 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// estimates samples needed by device to settle after retune
+// power of fixed size blocks is measured after every retune, settle point is first block after which power stays close to stable level
+class SettleEstimator {
+ public:
+  SettleEstimator(const int blockSize, const int blocks, const int settleSamples);
+
+  int getBlockSize() const;
+  int getBlocks() const;
+  int getSettleSamples() const;
+
+  // power in dB of measured blocks, can be called from many threads
+  void addMeasurement(const std::vector<float>& powers);
+
+  static int findSettleBlock(const std::vector<float>& powers);
+
+ private:
+  const int m_blockSize;
+  const int m_blocks;
+  std::mutex m_mutex;
+  std::deque<int> m_measurements;
+  std::atomic<int> m_settleSamples;
+};
@@ -3,37 +3,41 @@
 #include <config.h>
 #include <utils/utils.h>
 
-Signal::Signal(
-    const Config& config,
-    const Device& device,
-    const std::function<Frequency(const Index index)>& indexToFrequency,
-    const std::function<Frequency(const Index index)>& indexToShift,
-    const std::chrono::milliseconds& now)
-    : m_config(config), m_device(device), m_indexToFrequency(indexToFrequency), m_indexToShift(indexToShift), m_firstDataTime(now), m_lastDataTime(now), m_power(0.0) {}
-
-Signal::~Signal() {}
+Signal::Signal(const Config& config, const Device& device, const Index index, const int groupSize, const std::chrono::milliseconds& now)
+    : m_minTime(config.recordingMinTime()),
+      m_timeout(config.recordingTimeout()),
+      m_startLevel(device.start_recording_level),
+      m_stopLevel(device.stop_recording_level),
+      m_firstDataTime(now),
+      m_lastDataTime(now),
+      m_power(0.0),
+      m_indexes(index, groupSize / 2) {}
 
 void Signal::newData(const Index avgIndex, const float avgPower, const Index, const float, const std::chrono::milliseconds& now) {
   m_power = avgPower;
-  if (m_device.stop_recording_level <= avgPower) {
+  if (m_stopLevel <= avgPower) {
     m_lastDataTime = now;
   }
-  if (m_device.start_recording_level <= avgPower) {
-    m_indexes.push_back(avgIndex);
+  if (m_startLevel <= avgPower) {
+    m_indexes.add(avgIndex);
   }
 }
 
-bool Signal::isMinimalTime(const std::chrono::milliseconds& now) const { return m_firstDataTime + m_config.recordingMinTime() <= now; }
+bool Signal::isMinimalTime(const std::chrono::milliseconds& now) const { return m_firstDataTime + m_minTime <= now; }
 
 bool Signal::isMaximalTime(const std::chrono::milliseconds& now) const { return m_firstDataTime + TRANSMISSION_MAX_TIME <= now; }
 
-bool Signal::isTimeout(const std::chrono::milliseconds& now) const { return m_lastDataTime + m_config.recordingTimeout() <= now; }
+bool Signal::isTimeout(const std::chrono::milliseconds& now) const { return m_lastDataTime + m_timeout <= now; }
 
 bool Signal::needFlush(const std::chrono::milliseconds& now) const { return m_lastDataTime == now && isMinimalTime(now); }
 
 float Signal::getPower() const { return m_power; }
 
-Signal::Index Signal::getIndex() const { return mostFrequentValue(m_indexes); }
+Signal::Index Signal::getIndex() const { return m_indexes.mode(); }
+
+std::optional<Frequency> Signal::getShift() const { return m_shift; }
+
+void Signal::setShift(const Frequency shift) { m_shift = shift; }
 
 std::chrono::milliseconds Signal::getDuration() const { return m_lastDataTime - m_firstDataTime; }
 
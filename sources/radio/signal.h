@@ -2,21 +2,16 @@
 
 #include <config.h>
 #include <radio/help_structures.h>
+#include <radio/mode_estimator.h>
 
 #include <chrono>
-#include <functional>
+#include <optional>
 
 class Signal {
   using Index = int;
 
  public:
-  Signal(
-      const Config& config,
-      const Device& device,
-      const std::function<Frequency(const Index index)>& indexToFrequency,
-      const std::function<Frequency(const Index index)>& indexToShift,
-      const std::chrono::milliseconds& now);
-  ~Signal();
+  Signal(const Config& config, const Device& device, const Index index, const int groupSize, const std::chrono::milliseconds& now);
 
   void newData(const Index avgIndex, const float avgPower, const Index rawIndex, const float rawPower, const std::chrono::milliseconds& now);
 
@@ -26,16 +21,21 @@ class Signal {
   bool needFlush(const std::chrono::milliseconds& now) const;
   float getPower() const;
   Index getIndex() const;
+  // shift refined by zoom detection
+  std::optional<Frequency> getShift() const;
+  void setShift(const Frequency shift);
   std::chrono::milliseconds getDuration() const;
   std::chrono::milliseconds getLastDataTime(const std::chrono::milliseconds& now) const;
 
  private:
-  const Config& m_config;
-  const Device& m_device;
-  std::function<Frequency(const Index index)> m_indexToFrequency;
-  std::function<Frequency(const Index index)> m_indexToShift;
+  // thresholds are copied, signal has to be movable to be kept in flat table
+  std::chrono::milliseconds m_minTime;
+  std::chrono::milliseconds m_timeout;
+  float m_startLevel;
+  float m_stopLevel;
   std::chrono::milliseconds m_firstDataTime;
   std::chrono::milliseconds m_lastDataTime;
   float m_power;
-  std::vector<Index> m_indexes;
+  ModeEstimator m_indexes;
+  std::optional<Frequency> m_shift;
 };
\ No newline at end of file
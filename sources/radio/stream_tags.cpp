@@ -0,0 +1,100 @@
+#include "stream_tags.h"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr auto MAX_TIME_ERROR = std::chrono::milliseconds(1);  // bigger difference between anchored time and item counter is gap in stream
+
+pmt::pmt_t makeTimeTag(const std::chrono::nanoseconds time) {
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(time);
+  const auto fraction = std::chrono::duration<double>(time - seconds).count();
+  return pmt::make_tuple(pmt::from_uint64(seconds.count()), pmt::from_double(fraction));
+}
+
+std::chrono::nanoseconds readTimeTag(const pmt::pmt_t& value) {
+  const auto seconds = std::chrono::seconds(pmt::to_uint64(pmt::tuple_ref(value, 0)));
+  const auto fraction = std::chrono::duration<double>(pmt::to_double(pmt::tuple_ref(value, 1)));
+  return seconds + std::chrono::duration_cast<std::chrono::nanoseconds>(fraction);
+}
+
+pmt::pmt_t makeRetuneTag(const Frequency frequency) { return pmt::from_double(frequency); }
+
+Frequency readRetuneTag(const pmt::pmt_t& value) { return static_cast<Frequency>(pmt::to_double(value)); }
+
+pmt::pmt_t makeRangeTag(const int range) { return pmt::from_long(range); }
+
+int readRangeTag(const pmt::pmt_t& value) { return static_cast<int>(pmt::to_long(value)); }
+
+TimeTagReader::TimeTagReader(const double itemRate) : m_itemRate(itemRate), m_isValid(false), m_tagOffset(0), m_tagTime(0) {}
+
+std::vector<gr::tag_t>& TimeTagReader::tags() { return m_tags; }
+
+std::chrono::milliseconds TimeTagReader::getTime(const uint64_t offset) { return std::chrono::duration_cast<std::chrono::milliseconds>(getExactTime(offset)); }
+
+std::chrono::nanoseconds TimeTagReader::getExactTime(const uint64_t offset) {
+  // decimating blocks map many tags to the same item, first one is the closest to item start
+  for (const auto& tag : m_tags) {
+    if (tag.offset <= offset && (!m_isValid || m_tagOffset < tag.offset)) {
+      m_isValid = true;
+      m_tagOffset = tag.offset;
+      m_tagTime = readTimeTag(tag.value);
+    }
+  }
+  if (!m_isValid) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+  }
+  const auto delta = std::chrono::duration<double>((offset - m_tagOffset) / m_itemRate);
+  return m_tagTime + std::chrono::duration_cast<std::chrono::nanoseconds>(delta);
+}
+
+RangeTagReader::RangeTagReader() : m_range(-1), m_tagOffset(0) {}
+
+std::vector<gr::tag_t>& RangeTagReader::tags() { return m_tags; }
+
+int RangeTagReader::getRange(const uint64_t offset) {
+  for (const auto& tag : m_tags) {
+    if (tag.offset <= offset && m_tagOffset <= tag.offset) {
+      m_range = readRangeTag(tag.value);
+      m_tagOffset = tag.offset;
+    }
+  }
+  return m_range;
+}
+
+TimeAnchor::TimeAnchor(const double itemRate) : m_itemRate(itemRate), m_isValid(false), m_offset(0), m_time(0), m_gapOffset(0) {}
+
+void TimeAnchor::set(const uint64_t offset, const std::chrono::nanoseconds time) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_isValid) {
+    m_gapOffset = offset;
+  } else {
+    const auto delta = std::chrono::duration<double>((static_cast<double>(offset) - static_cast<double>(m_offset)) / m_itemRate);
+    if (MAX_TIME_ERROR < std::chrono::abs(time - m_time - std::chrono::duration_cast<std::chrono::nanoseconds>(delta))) {
+      m_gapOffset = offset;
+    }
+  }
+  m_isValid = true;
+  m_offset = offset;
+  m_time = time;
+}
+
+std::chrono::nanoseconds TimeAnchor::getTime(const uint64_t offset) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_isValid) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+  }
+  // reader may be behind anchor, delta is signed
+  const auto delta = std::chrono::duration<double>((static_cast<double>(offset) - static_cast<double>(m_offset)) / m_itemRate);
+  return m_time + std::chrono::duration_cast<std::chrono::nanoseconds>(delta);
+}
+
+std::optional<uint64_t> TimeAnchor::getOffset(const std::chrono::nanoseconds time) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_isValid) {
+    return std::nullopt;
+  }
+  // items before gap have times of other part of stream
+  const auto delta = std::round(std::chrono::duration<double>(time - m_time).count() * m_itemRate);
+  const auto offset = std::max(0.0, static_cast<double>(m_offset) + delta);
+  return std::max(m_gapOffset, static_cast<uint64_t>(offset));
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <gnuradio/tags.h>
+#include <pmt/pmt.h>
+#include <radio/help_structures.h>
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// stream tags use gnuradio conventions
+// rx_time: time of tagged item (full seconds, fractional seconds)
+// rx_freq: center frequency, tagged item is first sample received after retune
+// range: index of scanned range, tagged item is first frame of range after retune
+const pmt::pmt_t TIME_TAG = pmt::intern("rx_time");
+const pmt::pmt_t RETUNE_TAG = pmt::intern("rx_freq");
+const pmt::pmt_t RANGE_TAG = pmt::intern("range");
+
+pmt::pmt_t makeTimeTag(const std::chrono::nanoseconds time);
+std::chrono::nanoseconds readTimeTag(const pmt::pmt_t& value);
+
+pmt::pmt_t makeRetuneTag(const Frequency frequency);
+Frequency readRetuneTag(const pmt::pmt_t& value);
+
+pmt::pmt_t makeRangeTag(const int range);
+int readRangeTag(const pmt::pmt_t& value);
+
+// converts absolute item offsets to time based on latest time tag, items between tags are interpolated with item rate
+class TimeTagReader {
+ public:
+  TimeTagReader(const double itemRate);
+
+  // filled by block with get_tags_in_window before getTime calls
+  std::vector<gr::tag_t>& tags();
+  // offsets have to be non decreasing, system time is used until first tag
+  std::chrono::milliseconds getTime(const uint64_t offset);
+  std::chrono::nanoseconds getExactTime(const uint64_t offset);
+
+ private:
+  const double m_itemRate;
+  std::vector<gr::tag_t> m_tags;
+  bool m_isValid;
+  uint64_t m_tagOffset;
+  std::chrono::nanoseconds m_tagTime;
+};
+
+// converts absolute item offsets to range index based on latest range tag
+class RangeTagReader {
+ public:
+  RangeTagReader();
+
+  // filled by block with get_tags_in_window before getRange calls
+  std::vector<gr::tag_t>& tags();
+  // offsets have to be non decreasing, -1 until first tag
+  int getRange(const uint64_t offset);
+
+ private:
+  std::vector<gr::tag_t> m_tags;
+  int m_range;
+  uint64_t m_tagOffset;
+};
+
+// time of items in stream shared between threads, writer anchors item offset to time and readers tag their streams with it
+class TimeAnchor {
+ public:
+  TimeAnchor(const double itemRate);
+
+  void set(const uint64_t offset, const std::chrono::nanoseconds time);
+  // system time until first anchor
+  std::chrono::nanoseconds getTime(const uint64_t offset) const;
+  // offset of item with given time, not older than first item after last gap in stream, empty until first anchor
+  std::optional<uint64_t> getOffset(const std::chrono::nanoseconds time) const;
+
+ private:
+  const double m_itemRate;
+  mutable std::mutex m_mutex;
+  bool m_isValid;
+  uint64_t m_offset;
+  std::chrono::nanoseconds m_time;
+  uint64_t m_gapOffset;
+};
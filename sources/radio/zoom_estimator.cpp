@@ -0,0 +1,50 @@
+#include "zoom_estimator.h"
+
+#include <cmath>
+#include <numbers>
+
+ZoomEstimator::ZoomEstimator(const int frameSize, const int decimation, const Frequency sampleRate)
+    : m_frameSize(frameSize), m_decimation(decimation), m_sampleRate(sampleRate), m_window(frameSize / decimation), m_samples(frameSize / decimation) {
+  // hann window of decimated samples reduces leakage of neighbour signals
+  const auto size = static_cast<int>(m_window.size());
+  for (int i = 0; i < size; ++i) {
+    m_window[i] = 0.5f - 0.5f * std::cos(2.0f * std::numbers::pi_v<float> * i / size);
+  }
+}
+
+int ZoomEstimator::getBins() const { return m_samples.size(); }
+
+Frequency ZoomEstimator::estimate(const std::complex<float>* frame, const Frequency shift, const Frequency span) {
+  const auto bins = static_cast<int>(m_samples.size());
+  const auto omega = -2.0 * std::numbers::pi * shift / m_sampleRate;
+  for (int i = 0; i < bins; ++i) {
+    // mixer phase is computed exactly once per block, inside block it is rotated
+    const auto offset = i * m_decimation;
+    auto phase = std::polar(1.0f, static_cast<float>(std::fmod(omega * offset, 2.0 * std::numbers::pi)));
+    const auto step = std::polar(1.0f, static_cast<float>(omega));
+    std::complex<float> sum(0.0f, 0.0f);
+    for (int j = 0; j < m_decimation; ++j) {
+      sum += frame[offset + j] * phase;
+      phase *= step;
+    }
+    m_samples[i] = sum * m_window[i];
+  }
+
+  const auto binStep = static_cast<double>(m_sampleRate) / m_frameSize;
+  const auto maxBin = std::min(bins / 2 - 1, static_cast<int>(span / binStep));
+  auto bestBin = 0;
+  auto bestPower = -1.0f;
+  for (int k = -maxBin; k <= maxBin; ++k) {
+    const auto omegaK = -2.0 * std::numbers::pi * k / bins;
+    std::complex<float> sum(0.0f, 0.0f);
+    for (int i = 0; i < bins; ++i) {
+      sum += m_samples[i] * std::polar(1.0f, static_cast<float>(std::fmod(omegaK * i, 2.0 * std::numbers::pi)));
+    }
+    const auto power = std::norm(sum);
+    if (bestPower < power) {
+      bestPower = power;
+      bestBin = k;
+    }
+  }
+  return shift + static_cast<Frequency>(std::round(bestBin * binStep));
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <radio/help_structures.h>
+
+#include <complex>
+#include <vector>
+
+// zoom fft, finds frequency of strongest component close to given shift with full frame resolution
+// frame is mixed down by shift, decimated by summing blocks of samples and small dft is computed only around shift
+class ZoomEstimator {
+ public:
+  ZoomEstimator(const int frameSize, const int decimation, const Frequency sampleRate);
+
+  int getBins() const;
+  // frequencies are relative to frame center, result is within shift +- span
+  Frequency estimate(const std::complex<float>* frame, const Frequency shift, const Frequency span);
+
+ private:
+  const int m_frameSize;
+  const int m_decimation;
+  const Frequency m_sampleRate;
+  std::vector<float> m_window;
+  std::vector<std::complex<float>> m_samples;
+};
@@ -0,0 +1,39 @@
+#include "zoom_table.h"
+
+#include <algorithm>
+
+ZoomTable::ZoomTable(const int ranges) : m_indexes(ranges), m_shifts(ranges) {}
+
+void ZoomTable::setIndexes(const int range, const std::vector<Index>& indexes) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_indexes[range] = indexes;
+  // shifts of indexes that are no longer requested were consumed or their signals ended, new signal at such index gets fresh shift
+  std::erase_if(m_shifts[range], [&indexes](const std::pair<Index, Frequency>& kv) { return std::find(indexes.begin(), indexes.end(), kv.first) == indexes.end(); });
+}
+
+void ZoomTable::getIndexes(const int range, std::vector<Index>& indexes) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  indexes = m_indexes[range];
+}
+
+void ZoomTable::setShifts(const int range, const std::vector<std::pair<Index, Frequency>>& shifts) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // indexes may be withdrawn while zoom fft computed their shifts
+  const auto& indexes = m_indexes[range];
+  m_shifts[range].clear();
+  for (const auto& kv : shifts) {
+    if (std::find(indexes.begin(), indexes.end(), kv.first) != indexes.end()) {
+      m_shifts[range].push_back(kv);
+    }
+  }
+}
+
+std::optional<Frequency> ZoomTable::getShift(const int range, const Index index) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  const auto& shifts = m_shifts[range];
+  const auto it = std::find_if(shifts.begin(), shifts.end(), [index](const std::pair<Index, Frequency>& kv) { return kv.first == index; });
+  if (it != shifts.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <radio/help_structures.h>
+
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// exchanges zoom requests and results between transmission and zoom fft blocks
+// transmission requests coarse indexes of active signals, zoom fft answers with refined shift frequencies
+// shifts are kept only for requested indexes, withdrawn request removes its shift
+class ZoomTable {
+ public:
+  using Index = int;
+
+  ZoomTable(const int ranges);
+
+  void setIndexes(const int range, const std::vector<Index>& indexes);
+  void getIndexes(const int range, std::vector<Index>& indexes);
+  void setShifts(const int range, const std::vector<std::pair<Index, Frequency>>& shifts);
+  std::optional<Frequency> getShift(const int range, const Index index);
+
+ private:
+  std::mutex m_mutex;
+  std::vector<std::vector<Index>> m_indexes;
+  std::vector<std::vector<std::pair<Index, Frequency>>> m_shifts;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+// lock-free single producer multiple readers ring buffer with preallocated storage
+// producer never waits for readers, it overwrites oldest items, every reader has own cursor
+// reader that falls behind is moved forward and counts lost items
+// producer publishes reservation of slice before it overwrites items, reader checks reservation after it read items like sequence of seqlock
+template <typename T>
+class BroadcastRing {
+ public:
+  class Reader {
+   public:
+    Reader(std::shared_ptr<BroadcastRing> ring) : Reader(ring, ring->written()) {}
+    // reader may start from older items that are still in ring, position is clamped to them
+    Reader(std::shared_ptr<BroadcastRing> ring, const uint64_t position) : m_ring(ring), m_cursor(getStart(*ring, position)), m_lost(0) {
+      m_ring->m_readers.fetch_add(1, std::memory_order_acq_rel);
+    }
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+    ~Reader() { m_ring->m_readers.fetch_sub(1, std::memory_order_acq_rel); }
+
+    // items are valid only if commitRead confirms that producer did not overwrite them meanwhile
+    std::span<const T> readSlice() {
+      const auto head = m_ring->m_head.load(std::memory_order_acquire);
+      skipOverwritten(head);
+      const auto offset = m_cursor % m_ring->m_data.size();
+      const auto count = std::min(head - m_cursor, m_ring->m_data.size() - offset);
+      return {m_ring->m_data.data() + offset, count};
+    }
+
+    // rejected items are counted as lost
+    bool commitRead(const size_t count) {
+      // loads of items can not be moved after check of reservation, items are overwritten only by reserved slices
+      std::atomic_thread_fence(std::memory_order_acquire);
+      const auto reserved = m_ring->m_reserved.load(std::memory_order_relaxed);
+      const auto isValid = reserved - m_cursor <= m_ring->m_data.size();
+      m_cursor += count;
+      if (!isValid) {
+        m_lost += count;
+        skipOverwritten(m_ring->written());
+      }
+      return isValid;
+    }
+
+    uint64_t position() const { return m_cursor; }
+    uint64_t lag() const { return m_ring->written() - m_cursor; }
+    uint64_t lost() const { return m_lost; }
+
+   private:
+    static uint64_t getStart(const BroadcastRing& ring, const uint64_t position) {
+      // reader starts at most half of safe lag behind, like reader that was overrun
+      const auto head = ring.written();
+      return std::clamp(position, head - std::min<uint64_t>(head, ring.safeLag() / 2), head);
+    }
+
+    void skipOverwritten(const uint64_t head) {
+      // item under cursor may be overwritten by write in progress, reader jumps to newest items
+      if (m_ring->safeLag() < head - m_cursor) {
+        const auto cursor = head - m_ring->safeLag() / 2;
+        m_lost += cursor - m_cursor;
+        m_cursor = cursor;
+      }
+    }
+
+    const std::shared_ptr<BroadcastRing> m_ring;
+    uint64_t m_cursor;
+    uint64_t m_lost;
+  };
+
+  BroadcastRing(const size_t capacity) : m_data(capacity), m_maxWrite(std::max<size_t>(1, capacity / 4)), m_head(0), m_reserved(0), m_readers(0) {}
+  BroadcastRing(const BroadcastRing&) = delete;
+  BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+  // producer, whole slice is reserved before it is returned, single write is limited so readers can skip items that will be overwritten
+  std::span<T> writeSlice() {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    const auto offset = head % m_data.size();
+    const auto size = std::min(m_maxWrite, m_data.size() - offset);
+    // stores of items can not be moved before reservation
+    m_reserved.store(head + size, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return {m_data.data() + offset, size};
+  }
+
+  void commitWrite(const size_t count) { m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release); }
+
+  void write(const T* data, const size_t count) {
+    size_t total = 0;
+    while (total < count) {
+      const auto slice = writeSlice();
+      const auto size = std::min(slice.size(), count - total);
+      std::copy(data + total, data + total + size, slice.data());
+      commitWrite(size);
+      total += size;
+    }
+  }
+
+  // statistics, safe to call from any thread
+  bool hasReaders() const { return 0 < readers(); }
+  int readers() const { return m_readers.load(std::memory_order_acquire); }
+  size_t capacity() const { return m_data.size(); }
+  uint64_t written() const { return m_head.load(std::memory_order_acquire); }
+
+ private:
+  size_t safeLag() const { return m_data.size() - m_maxWrite; }
+
+  std::vector<T> m_data;
+  const size_t m_maxWrite;
+  alignas(64) std::atomic<uint64_t> m_head;
+  std::atomic<uint64_t> m_reserved;
+  alignas(64) std::atomic<int> m_readers;
+};
@@ -4,6 +4,7 @@
 #include <map>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 template <typename T>
 int getMaxIndex(const T* data, const int size, const int index, const int groupSize) {
@@ -26,6 +27,20 @@ std::optional<int> containsWithMargin(const std::map<int, T>& indexes, const int
   }
 }
 
+// flat table sorted by index
+template <typename T>
+std::optional<int> containsWithMargin(const std::vector<std::pair<int, T>>& indexes, const int index, const int margin) {
+  const auto submargin = margin % 2 == 0 ? margin / 2 : margin / 2 + 1;
+  const auto left = index - submargin;
+  const auto right = index + submargin;
+  auto it = std::lower_bound(indexes.begin(), indexes.end(), left, [](const std::pair<int, T>& kv, const int value) { return kv.first < value; });
+  if (it != indexes.end() && it->first <= right) {
+    return it->first;
+  } else {
+    return std::nullopt;
+  }
+}
+
 template <typename T>
 T mostFrequentValue(const std::vector<T>& data) {
   auto f = [](const auto& v1, const auto& v2) {
@@ -0,0 +1,145 @@
+#include "dsp_utils.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace {
+constexpr auto DB_PER_LOG2 = 3.01029995664f;  // 10 * log10(2)
+constexpr auto SELECT_BLOCK_SIZE = 64;
+
+inline float approximateDb(const float x) {
+  // x = 2^e * m, where m in [1, 2), log2(m) is 4th degree least squares polynomial
+  const auto bits = std::bit_cast<int32_t>(x);
+  const auto exponent = static_cast<float>((bits >> 23) - 127);
+  const auto m = std::bit_cast<float>((bits & 0x007FFFFF) | 0x3F800000);
+  const auto log2m = -2.4968459f + m * (4.0285475f + m * (-2.08121371f + m * (0.628873414f + m * -0.0791581277f)));
+  return DB_PER_LOG2 * (exponent + log2m);
+}
+}  // namespace
+
+float fastDb(const float x) { return approximateDb(x); }
+
+void powerToDb(const std::complex<float>* input, float* output, const int size, const float offset) {
+  // plain loop without branches is vectorized by compiler (sse, avx, neon)
+  const float* in = reinterpret_cast<const float*>(input);
+  for (int i = 0; i < size; ++i) {
+    const auto re = in[2 * i];
+    const auto im = in[2 * i + 1];
+    output[i] = approximateDb(re * re + im * im) + offset;
+  }
+}
+
+void powerToHistory(const std::complex<float>* input, const float* noise, float* power, float* row, float* sum, const int size, const float offset) {
+  const float* in = reinterpret_cast<const float*>(input);
+  for (int i = 0; i < size; ++i) {
+    const auto re = in[2 * i];
+    const auto im = in[2 * i + 1];
+    const auto value = approximateDb(re * re + im * im) + offset;
+    power[i] = value;
+    sum[i] += value - noise[i] - row[i];
+    row[i] = value - noise[i];
+  }
+}
+
+void addPower(const std::complex<float>* input, float* sum, const int size) {
+  const float* in = reinterpret_cast<const float*>(input);
+  for (int i = 0; i < size; ++i) {
+    const auto re = in[2 * i];
+    const auto im = in[2 * i + 1];
+    sum[i] += re * re + im * im;
+  }
+}
+
+void linearToDb(const float* input, float* output, const int size, const float offset) {
+  for (int i = 0; i < size; ++i) {
+    output[i] = approximateDb(input[i]) + offset;
+  }
+}
+
+int selectIndexes(const float* data, const uint8_t* mask, const float threshold, const int size, int* indexes) {
+  int count = 0;
+  for (int start = 0; start < size; start += SELECT_BLOCK_SIZE) {
+    const auto end = std::min(size, start + SELECT_BLOCK_SIZE);
+    int hits = 0;
+    for (int i = start; i < end; ++i) {
+      hits += (mask[i] != 0) & (threshold <= data[i]);
+    }
+    if (hits == 0) {
+      continue;
+    }
+    // index is always written, counter moves only for candidates
+    for (int i = start; i < end; ++i) {
+      indexes[count] = i;
+      count += (mask[i] != 0) & (threshold <= data[i]);
+    }
+  }
+  return count;
+}
+
+void boxFilter(const float* input, double* prefix, float* output, const int size, const int groupSize, const int divisor) {
+  // double prefix keeps precision of long sums of negative decibels
+  const auto a = groupSize / 2;
+  prefix[0] = 0.0;
+  for (int i = 0; i < size; ++i) {
+    prefix[i + 1] = prefix[i] + input[i];
+  }
+
+  const auto window = [&](const int i) {
+    const auto first = std::max(0, i - a);
+    const auto last = std::min(size - 1, i + a);
+    output[i] = static_cast<float>((prefix[last + 1] - prefix[first]) / ((last - first + 1) * divisor));
+  };
+  const auto interiorStart = std::min(a, size);
+  const auto interiorEnd = std::max(interiorStart, size - a);
+  for (int i = 0; i < interiorStart; ++i) {
+    window(i);
+  }
+  const auto interiorScale = 1.0 / ((2 * a + 1) * divisor);
+  for (int i = interiorStart; i < interiorEnd; ++i) {
+    output[i] = static_cast<float>((prefix[i + a + 1] - prefix[i - a]) * interiorScale);
+  }
+  for (int i = interiorEnd; i < size; ++i) {
+    window(i);
+  }
+}
+
+void cfar(const float* input, double* prefix, float* output, const int size, const int guard, const int reference) {
+  prefix[0] = 0.0;
+  for (int i = 0; i < size; ++i) {
+    prefix[i + 1] = prefix[i] + input[i];
+  }
+
+  const auto window = [&](const int i) {
+    const auto leftFirst = std::clamp(i - guard - reference, 0, size);
+    const auto leftLast = std::clamp(i - guard, 0, size);
+    const auto rightFirst = std::clamp(i + guard + 1, 0, size);
+    const auto rightLast = std::clamp(i + guard + reference + 1, 0, size);
+    // side clipped to nothing at edge does not take part
+    auto mean = -std::numeric_limits<double>::max();
+    if (leftFirst < leftLast) {
+      mean = (prefix[leftLast] - prefix[leftFirst]) / (leftLast - leftFirst);
+    }
+    if (rightFirst < rightLast) {
+      mean = std::max(mean, (prefix[rightLast] - prefix[rightFirst]) / (rightLast - rightFirst));
+    }
+    output[i] = mean == -std::numeric_limits<double>::max() ? 0.0f : input[i] - static_cast<float>(mean);
+  };
+  // both reference windows are complete in interior
+  const auto margin = guard + reference;
+  const auto interiorStart = std::min(margin, size);
+  const auto interiorEnd = std::max(interiorStart, size - margin);
+  for (int i = 0; i < interiorStart; ++i) {
+    window(i);
+  }
+  const auto interiorScale = 1.0 / reference;
+  for (int i = interiorStart; i < interiorEnd; ++i) {
+    const auto left = prefix[i - guard] - prefix[i - margin];
+    const auto right = prefix[i + margin + 1] - prefix[i + guard + 1];
+    output[i] = input[i] - static_cast<float>(std::max(left, right) * interiorScale);
+  }
+  for (int i = interiorEnd; i < size; ++i) {
+    window(i);
+  }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+
+// max error of fast decibel approximation
+constexpr auto FAST_DB_MAX_ERROR = 0.001f;
+
+// 10 * log10(x) approximated from float exponent and polynomial of mantissa, x has to be positive
+float fastDb(const float x);
+
+// output[i] = 10 * log10(|input[i]|^2) + offset, power and decibels in single pass without sqrt, pow and log calls
+void powerToDb(const std::complex<float>* input, float* output, const int size, const float offset);
+
+// fused detection pass, power[i] = 10 * log10(|input[i]|^2) + offset, value = power[i] - noise[i]
+// value replaces row[i] and difference of them is added to sum[i], row is oldest frame of running time sum
+void powerToHistory(const std::complex<float>* input, const float* noise, float* power, float* row, float* sum, const int size, const float offset);
+
+// sum[i] += |input[i]|^2, linear power is accumulated before conversion to decibels
+void addPower(const std::complex<float>* input, float* sum, const int size);
+
+// output[i] = 10 * log10(input[i]) + offset
+void linearToDb(const float* input, float* output, const int size, const float offset);
+
+// writes indexes where mask[i] != 0 and threshold <= data[i] in increasing order, returns count, indexes has to fit size values
+// blocks without any candidate are rejected by vectorized check, cost grows with number of candidates instead of size
+int selectIndexes(const float* data, const uint8_t* mask, const float threshold, const int size, int* indexes);
+
+// greatest-of cell averaging cfar, output[i] = input[i] - greater of means of reference cells on left and right side of i
+// reference cells are separated from i by guard cells, greater mean keeps steps of noise floor from being detected at their edges
+// signal closer than guard + reference cells to stronger one is attenuated by it
+// reference windows are clipped at edges, prefix has to fit size + 1 values
+void cfar(const float* input, double* prefix, float* output, const int size, const int guard, const int reference);
+
+// output[i] = mean of input[i - groupSize / 2, i + groupSize / 2] / divisor, window is clipped at edges
+// prefix has to fit size + 1 values, interior is computed without branches from prefix sums
+void boxFilter(const float* input, double* prefix, float* output, const int size, const int groupSize, const int divisor);
@@ -1,8 +1,11 @@
 #include "radio_utils.h"
 
+#include <config.h>
 #include <logger.h>
 #include <utils/utils.h>
 
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <numeric>
 
@@ -119,6 +122,31 @@ int getFft(const Frequency sampleRate, const Frequency maxStep) {
   return newFft;
 }
 
+std::string getWisdomFileName(const std::string& dir, const std::string& cpu, const int cores) {
+  std::string name;
+  for (const auto c : cpu) {
+    if (std::isalnum(static_cast<unsigned char>(c))) {
+      name += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    } else if (!name.empty() && name.back() != '_') {
+      name += '_';
+    }
+  }
+  if (!name.empty() && name.back() == '_') {
+    name.pop_back();
+  }
+  return fmt::format("{}/fftw_wisdom_{}_{}.dat", dir, name.empty() ? "unknown" : name, cores);
+}
+
+int getFftThreads(const int fftSize, const int cores) {
+  // threads pay off only for long transforms, small ffts are faster in one thread
+  const auto maxThreads = std::clamp(cores / 2, 1, FFT_MAX_THREADS);
+  return std::clamp(fftSize / FFT_THREAD_MIN_SIZE, 1, maxThreads);
+}
+
+int getFftBatch(const int fftSize) { return std::clamp(FFT_BATCH_SAMPLES / fftSize, 1, FFT_MAX_BATCH); }
+
+int scaleBins(const int bins, const int binRatio) { return bins <= 0 ? bins : std::max(1, (bins + binRatio / 2) / binRatio); }
+
 std::vector<int> getPrimeFactors(int n) {
   if (n == 1) {
     return {1};
@@ -208,4 +236,19 @@ std::vector<FrequencyRange> splitRanges(const std::vector<FrequencyRange>& range
     }
   }
   return results;
-}
\ No newline at end of file
+}
+
+std::vector<uint8_t> getAllowedIndexes(const FrequencyRange& range, const std::vector<FrequencyRange>& ignoredRanges, const int size, const std::function<Frequency(const int index)>& indexToFrequency) {
+  std::vector<Frequency> frequencies(size);
+  std::vector<uint8_t> allowed(size);
+  for (int i = 0; i < size; ++i) {
+    frequencies[i] = indexToFrequency(i);
+    allowed[i] = range.contains(frequencies[i]) ? 1 : 0;
+  }
+  for (const auto& ignoredRange : ignoredRanges) {
+    const auto first = std::lower_bound(frequencies.begin(), frequencies.end(), ignoredRange.start);
+    const auto last = std::upper_bound(first, frequencies.end(), ignoredRange.stop);
+    std::fill(allowed.begin() + std::distance(frequencies.begin(), first), allowed.begin() + std::distance(frequencies.begin(), last), 0);
+  }
+  return allowed;
+}
@@ -2,6 +2,8 @@
 
 #include <radio/help_structures.h>
 
+#include <functional>
+
 std::string formatFrequency(const Frequency frequency, const char* color = nullptr);
 
 std::string formatFrequencyRange(const FrequencyRange range, const char* color = nullptr);
@@ -16,6 +18,16 @@ Frequency getTunedFrequency(Frequency frequency, Frequency step);
 
 int getFft(const Frequency sampleRate, Frequency maxStep);
 
+// wisdom is valid only for cpu it was measured on, file name contains cpu model and number of cores
+std::string getWisdomFileName(const std::string& dir, const std::string& cpu, const int cores);
+
+int getFftThreads(const int fftSize, const int cores);
+
+int getFftBatch(const int fftSize);
+
+// settings counted in full resolution bins converted to detection bins binRatio times wider, unset values (zero) are kept
+int scaleBins(const int bins, const int binRatio);
+
 std::vector<int> getPrimeFactors(int n);
 
 std::vector<std::pair<int, int>> getResamplersFactors(const Frequency sampleRate, const Frequency bandwidth, const int threshold);
@@ -26,4 +38,7 @@ Frequency getRangeSplitSampleRate(Frequency sampleRate);
 
 std::vector<FrequencyRange> splitRange(const FrequencyRange& range, Frequency sampleRate);
 
-std::vector<FrequencyRange> splitRanges(const std::vector<FrequencyRange>& ranges, Frequency sampleRate);
\ No newline at end of file
+std::vector<FrequencyRange> splitRanges(const std::vector<FrequencyRange>& ranges, Frequency sampleRate);
+
+// mask of fft bins allowed for detection, bin frequency is inside range and outside of all ignored ranges, frequencies have to grow with index
+std::vector<uint8_t> getAllowedIndexes(const FrequencyRange& range, const std::vector<FrequencyRange>& ignoredRanges, const int size, const std::function<Frequency(const int index)>& indexToFrequency);
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// lock-free single producer single consumer ring buffer with preallocated storage
+// producer and consumer work on contiguous slices, no copying inside the buffer
+template <typename T>
+class RingBuffer {
+ public:
+  RingBuffer(const size_t capacity) : m_data(capacity), m_head(0), m_tail(0), m_overflows(0) {}
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  // producer
+  std::span<T> writeSlice() {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    const auto offset = head % m_data.size();
+    const auto count = std::min(m_data.size() - (head - tail), m_data.size() - offset);
+    return {m_data.data() + offset, count};
+  }
+
+  void commitWrite(const size_t count) { m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release); }
+
+  void addOverflow(const size_t count) { m_overflows.fetch_add(count, std::memory_order_relaxed); }
+
+  // consumer
+  std::span<const T> readSlice() const {
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    const auto head = m_head.load(std::memory_order_acquire);
+    const auto offset = tail % m_data.size();
+    const auto count = std::min(head - tail, m_data.size() - offset);
+    return {m_data.data() + offset, count};
+  }
+
+  void commitRead(const size_t count) { m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release); }
+
+  // statistics, safe to call from any thread
+  size_t size() const {
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    return m_head.load(std::memory_order_acquire) - tail;
+  }
+  size_t capacity() const { return m_data.size(); }
+  uint64_t written() const { return m_head.load(std::memory_order_acquire); }
+  uint64_t overflows() const { return m_overflows.load(std::memory_order_relaxed); }
+
+ private:
+  std::vector<T> m_data;
+  alignas(64) std::atomic<uint64_t> m_head;
+  alignas(64) std::atomic<uint64_t> m_tail;
+  alignas(64) std::atomic<uint64_t> m_overflows;
+};
@@ -0,0 +1,144 @@
+#include "shared_ring.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+constexpr auto HEADER_SIZE = 4096;  // samples start at page boundary
+
+size_t getSize(const uint64_t capacity) { return HEADER_SIZE + capacity * sizeof(std::complex<float>); }
+
+std::runtime_error makeError(const std::string& message, const std::string& name) { return std::runtime_error(message + ": " + name + ", " + std::strerror(errno)); }
+}  // namespace
+
+static_assert(sizeof(SharedRingHeader) <= HEADER_SIZE);
+
+SharedRingWriter::SharedRingWriter(const std::string& name, const uint64_t capacity, const int64_t sampleRate) : m_name(name), m_size(getSize(capacity)) {
+  shm_unlink(m_name.c_str());
+  const auto fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    throw makeError("shared ring create failed", m_name);
+  }
+  if (ftruncate(fd, static_cast<off_t>(m_size)) != 0) {
+    close(fd);
+    shm_unlink(m_name.c_str());
+    throw makeError("shared ring resize failed", m_name);
+  }
+  void* memory = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    shm_unlink(m_name.c_str());
+    throw makeError("shared ring map failed", m_name);
+  }
+
+  m_header = new (memory) SharedRingHeader{};
+  m_data = reinterpret_cast<std::complex<float>*>(static_cast<uint8_t*>(memory) + HEADER_SIZE);
+  m_header->headerSize = HEADER_SIZE;
+  m_header->sampleSize = sizeof(std::complex<float>);
+  m_header->capacity = capacity;
+  m_header->maxWrite = std::max<uint64_t>(1, capacity / 4);
+  m_header->sampleRate = sampleRate;
+  m_header->version = SharedRingHeader::VERSION;
+  // readers check magic last, header is complete when it is visible
+  std::atomic_thread_fence(std::memory_order_release);
+  m_header->magic = SharedRingHeader::MAGIC;
+}
+
+SharedRingWriter::~SharedRingWriter() {
+  munmap(m_header, m_size);
+  shm_unlink(m_name.c_str());
+}
+
+void SharedRingWriter::write(const std::complex<float>* data, const uint64_t count) {
+  const auto capacity = m_header->capacity;
+  auto cursor = m_header->writeCursor.load(std::memory_order_relaxed);
+  uint64_t total = 0;
+  while (total < count) {
+    const auto offset = cursor % capacity;
+    const auto size = std::min({count - total, capacity - offset, m_header->maxWrite});
+    // reservation is visible before any of samples it overwrites
+    m_header->reserveCursor.store(cursor + size, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(m_data + offset, data + total, size * sizeof(std::complex<float>));
+    cursor += size;
+    total += size;
+    m_header->writeCursor.store(cursor, std::memory_order_release);
+  }
+}
+
+void SharedRingWriter::setRetune(const int64_t centerFrequency, const uint64_t cursor) {
+  const auto sequence = m_header->retuneSequence.load(std::memory_order_relaxed);
+  m_header->retuneSequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  m_header->centerFrequency.store(centerFrequency, std::memory_order_relaxed);
+  m_header->retuneCursor.store(cursor, std::memory_order_relaxed);
+  m_header->retuneSequence.store(sequence + 2, std::memory_order_release);
+}
+
+uint64_t SharedRingWriter::written() const { return m_header->writeCursor.load(std::memory_order_acquire); }
+
+SharedRingReader::SharedRingReader(const std::string& name) {
+  const auto fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw makeError("shared ring open failed", name);
+  }
+  struct stat status{};
+  if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < HEADER_SIZE) {
+    close(fd);
+    throw makeError("shared ring is not ready", name);
+  }
+  m_size = status.st_size;
+  void* memory = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    throw makeError("shared ring map failed", name);
+  }
+  m_header = static_cast<const SharedRingHeader*>(memory);
+  m_data = reinterpret_cast<const std::complex<float>*>(static_cast<const uint8_t*>(memory) + HEADER_SIZE);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (m_header->magic != SharedRingHeader::MAGIC || m_header->version != SharedRingHeader::VERSION || m_size < getSize(m_header->capacity)) {
+    munmap(const_cast<SharedRingHeader*>(m_header), m_size);
+    throw std::runtime_error("shared ring has unknown format: " + name);
+  }
+}
+
+SharedRingReader::~SharedRingReader() { munmap(const_cast<SharedRingHeader*>(m_header), m_size); }
+
+const SharedRingHeader& SharedRingReader::header() const { return *m_header; }
+
+uint64_t SharedRingReader::written() const { return m_header->writeCursor.load(std::memory_order_acquire); }
+
+SharedRingRetune SharedRingReader::retune() const {
+  while (true) {
+    const auto sequence = m_header->retuneSequence.load(std::memory_order_acquire);
+    const auto centerFrequency = m_header->centerFrequency.load(std::memory_order_relaxed);
+    const auto cursor = m_header->retuneCursor.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence % 2 == 0 && sequence == m_header->retuneSequence.load(std::memory_order_relaxed)) {
+      return {sequence / 2, centerFrequency, cursor};
+    }
+  }
+}
+
+bool SharedRingReader::read(const uint64_t cursor, std::complex<float>* data, const uint64_t count) const {
+  const auto capacity = m_header->capacity;
+  if (written() < cursor + count || capacity < m_header->reserveCursor.load(std::memory_order_acquire) - cursor) {
+    return false;
+  }
+  uint64_t total = 0;
+  while (total < count) {
+    const auto offset = (cursor + total) % capacity;
+    const auto size = std::min(count - total, capacity - offset);
+    std::memcpy(data + total, m_data + offset, size * sizeof(std::complex<float>));
+    total += size;
+  }
+  // loads of samples can not be moved after check of reservation
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return m_header->reserveCursor.load(std::memory_order_relaxed) - cursor <= capacity;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <string>
+
+// named ring of complex float samples in shared memory (/dev/shm), written by scanner and read by any number of local processes
+// layout is header followed by capacity samples, sample with cursor position n is stored at index n % capacity
+// writer never waits, it writes at most maxWrite samples at once:
+// 1. reserveCursor is set to the end of the write, then release fence is issued
+// 2. samples are copied to the ring
+// 3. writeCursor is set to the end of the write with release store
+// reader copies samples from position p below writeCursor, issues acquire fence and then loads reserveCursor,
+// samples are valid if reserveCursor - p <= capacity, writer did not start to overwrite them while they were copied
+struct SharedRingHeader {
+  static constexpr uint32_t MAGIC = 0x52445153;  // "SQDR"
+  static constexpr uint32_t VERSION = 2;
+
+  uint32_t magic;
+  uint32_t version;
+  uint32_t headerSize;
+  uint32_t sampleSize;
+  uint64_t capacity;
+  uint64_t maxWrite;
+  int64_t sampleRate;
+  // seqlock of retune, odd while retune is written, number of retunes is retuneSequence / 2
+  alignas(64) std::atomic<uint64_t> retuneSequence;
+  std::atomic<int64_t> centerFrequency;
+  std::atomic<uint64_t> retuneCursor;
+  // number of samples written since start
+  alignas(64) std::atomic<uint64_t> writeCursor;
+  // end of write in progress, equal to writeCursor between writes
+  std::atomic<uint64_t> reserveCursor;
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free);
+
+struct SharedRingRetune {
+  uint64_t sequence;
+  int64_t centerFrequency;
+  uint64_t cursor;
+};
+
+// writer creates ring, removes existing ring with the same name and unlinks it when destroyed
+class SharedRingWriter {
+ public:
+  SharedRingWriter(const std::string& name, const uint64_t capacity, const int64_t sampleRate);
+  SharedRingWriter(const SharedRingWriter&) = delete;
+  SharedRingWriter& operator=(const SharedRingWriter&) = delete;
+  ~SharedRingWriter();
+
+  void write(const std::complex<float>* data, const uint64_t count);
+  // first sample after retune has given cursor position
+  void setRetune(const int64_t centerFrequency, const uint64_t cursor);
+  uint64_t written() const;
+
+ private:
+  const std::string m_name;
+  size_t m_size;
+  SharedRingHeader* m_header;
+  std::complex<float>* m_data;
+};
+
+// read only mapping of ring created by writer, reference for external consumers
+class SharedRingReader {
+ public:
+  SharedRingReader(const std::string& name);
+  SharedRingReader(const SharedRingReader&) = delete;
+  SharedRingReader& operator=(const SharedRingReader&) = delete;
+  ~SharedRingReader();
+
+  const SharedRingHeader& header() const;
+  uint64_t written() const;
+  SharedRingRetune retune() const;
+  // copies samples from cursor position, false when they are not written yet, no longer available or were overwritten while copying
+  bool read(const uint64_t cursor, std::complex<float>* data, const uint64_t count) const;
+
+ private:
+  size_t m_size;
+  const SharedRingHeader* m_header;
+  const std::complex<float>* m_data;
+};
@@ -3,6 +3,8 @@
 #include <config.h>
 #include <logger.h>
 #include <math.h>
+#include <pthread.h>
+#include <sched.h>
 #include <spdlog/spdlog.h>
 #include <time.h>
 
@@ -21,30 +23,6 @@ std::string randomHex(std::size_t hex_count) {
   return oss.str();
 }
 
-void average(const float* input, float* output, int size, int groupSize) {
-  const auto a = groupSize / 2;
-  float sum = 0.0;
-  int count = 0;
-
-  auto isIndexValid = [size](int i) { return 0 <= i && i < size; };
-
-  for (int i = -a; i < size + a - 1; ++i) {
-    const auto first = i - a - 1;
-    const auto last = i + a;
-    if (isIndexValid(first)) {
-      sum -= input[first];
-      count--;
-    }
-    if (isIndexValid(last)) {
-      sum += input[last];
-      count++;
-    }
-    if (isIndexValid(i)) {
-      output[i] = sum / count;
-    }
-  }
-}
-
 int roundUp(const int value, const int factor) {
   if (value % factor == 0) {
     return value;
@@ -53,4 +31,11 @@ int roundUp(const int value, const int factor) {
   }
 }
 
-int roundDown(const int value, const int factor) { return value / factor * factor; }
\ No newline at end of file
+int roundDown(const int value, const int factor) { return value / factor * factor; }
+
+bool setThreadAffinity(std::thread& thread, const int cpu) {
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu, &cpuset);
+  return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuset) == 0;
+}
\ No newline at end of file
@@ -7,17 +7,18 @@
 #include <boost/beast/core/detail/base64.hpp>
 #include <chrono>
 #include <string>
+#include <thread>
 
 std::chrono::milliseconds getTime();
 
 std::string randomHex(std::size_t hex_count);
 
-void average(const float* input, float* output, int size, int groupSize);
-
 int roundUp(const int value, const int factor);
 
 int roundDown(const int value, const int factor);
 
+bool setThreadAffinity(std::thread& thread, const int cpu);
+
 template <typename T>
 std::string encode_base64(const T* data, std::size_t size) {
   const auto bytes = sizeof(T) * size;
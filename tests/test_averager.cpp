@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <radio/averager.h>
+#include <utils/dsp_utils.h>
 #include <utils/utils.h>
 
 #include <deque>
@@ -9,6 +10,13 @@ constexpr auto GROUP_SIZE = 3;
 
 std::vector<float> generate(const float value) { return std::vector<float>(SIZE, value); }
 std::deque<std::vector<float>> generateRaw(const float v1, const float v2, const float v3) { return {generate(v1), generate(v2), generate(v3)}; }
+std::deque<std::vector<float>> history(const Averager& averager) {
+  std::deque<std::vector<float>> rows;
+  for (int i = 0; i < averager.rows(); ++i) {
+    rows.emplace_back(averager.row(i), averager.row(i) + SIZE);
+  }
+  return rows;
+}
 
 class AveragerTest : public testing::Test {
  public:
@@ -46,33 +54,33 @@ class AveragerTest : public testing::Test {
 TEST_F(AveragerTest, SimpleTest) {
   add({1, 2, 3, 4, 5});
   EXPECT_EQ(m_averager.average(), generate(-100));
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(history(m_averager), m_rawData);
 
   add({2, 3, 4, 5, 6});
   EXPECT_EQ(m_averager.average(), generate(-100));
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(history(m_averager), m_rawData);
 
   add({3, 4, 5, 6, 7});
   EXPECT_EQ(m_averager.average(), average());
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(history(m_averager), m_rawData);
 
   add({6, 7, 8, 9, 10});
   EXPECT_EQ(m_averager.average(), average());
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(history(m_averager), m_rawData);
 
   add({7, 8, 9, 10, 11});
   EXPECT_EQ(m_averager.average(), average());
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(history(m_averager), m_rawData);
 }
 
 TEST_F(AveragerTest, SimpleBigTest) {
   add({1, 2, 3, 4, 5});
   EXPECT_EQ(m_averager.average(), generate(-100));
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(history(m_averager), m_rawData);
 
   add({2, 3, 4, 5, 6});
   EXPECT_EQ(m_averager.average(), generate(-100));
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(history(m_averager), m_rawData);
 
   for (int i = 1; i < 123; ++i) {
     std::vector<float> data;
@@ -81,7 +89,7 @@ TEST_F(AveragerTest, SimpleBigTest) {
     }
     add(data);
     EXPECT_EQ(m_averager.average(), average());
-    EXPECT_EQ(m_averager.data(), m_rawData);
+    EXPECT_EQ(history(m_averager), m_rawData);
   }
 }
 
@@ -92,49 +100,87 @@ TEST(Averager, SimpleTest) {
   Averager avg(size, 3);
 
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 0, 0));
+  EXPECT_EQ(history(avg), generateRaw(0, 0, 0));
 
   avg.push(generate(1).data());
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 0, 1));
+  EXPECT_EQ(history(avg), generateRaw(0, 0, 1));
 
   avg.push(generate(2).data());
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 1, 2));
+  EXPECT_EQ(history(avg), generateRaw(0, 1, 2));
 
   avg.push(generate(3).data());
   EXPECT_EQ(avg.average(), generate(2));
-  EXPECT_EQ(avg.data(), generateRaw(1, 2, 3));
+  EXPECT_EQ(history(avg), generateRaw(1, 2, 3));
 
   avg.push(generate(10).data());
   EXPECT_EQ(avg.average(), generate(5));
-  EXPECT_EQ(avg.data(), generateRaw(2, 3, 10));
+  EXPECT_EQ(history(avg), generateRaw(2, 3, 10));
 
   avg.push(generate(11).data());
   EXPECT_EQ(avg.average(), generate(8));
-  EXPECT_EQ(avg.data(), generateRaw(3, 10, 11));
+  EXPECT_EQ(history(avg), generateRaw(3, 10, 11));
 
   avg.reset();
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 0, 0));
+  EXPECT_EQ(history(avg), generateRaw(0, 0, 0));
 
   avg.push(generate(1).data());
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 0, 1));
+  EXPECT_EQ(history(avg), generateRaw(0, 0, 1));
 
   avg.push(generate(2).data());
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 1, 2));
+  EXPECT_EQ(history(avg), generateRaw(0, 1, 2));
 
   avg.push(generate(3).data());
   EXPECT_EQ(avg.average(), generate(2));
-  EXPECT_EQ(avg.data(), generateRaw(1, 2, 3));
+  EXPECT_EQ(history(avg), generateRaw(1, 2, 3));
 
   avg.push(generate(10).data());
   EXPECT_EQ(avg.average(), generate(5));
-  EXPECT_EQ(avg.data(), generateRaw(2, 3, 10));
+  EXPECT_EQ(history(avg), generateRaw(2, 3, 10));
 
   avg.push(generate(11).data());
   EXPECT_EQ(avg.average(), generate(8));
-  EXPECT_EQ(avg.data(), generateRaw(3, 10, 11));
+  EXPECT_EQ(history(avg), generateRaw(3, 10, 11));
+}
+
+TEST(Averager, FusedPush) {
+  constexpr auto size = 64;
+  constexpr auto offset = -60.0f;
+  Averager staged(size, GROUP_SIZE, 5);
+  Averager fused(size, GROUP_SIZE, 5);
+  std::vector<float> noise(size);
+  for (int i = 0; i < size; ++i) {
+    noise[i] = -10.0f + 0.1f * i;
+  }
+
+  // fused push gives the same power, history and average as power to decibels, noise subtraction and push
+  for (int frame = 0; frame < 2 * GROUP_SIZE; ++frame) {
+    std::vector<std::complex<float>> input(size);
+    for (int i = 0; i < size; ++i) {
+      input[i] = {0.01f * (i + 1), 0.02f * (frame + 1)};
+    }
+    std::vector<float> stagedPower(size);
+    std::vector<float> fusedPower(size);
+    powerToDb(input.data(), stagedPower.data(), size, offset);
+    std::vector<float> noiseFree(size);
+    for (int i = 0; i < size; ++i) {
+      noiseFree[i] = stagedPower[i] - noise[i];
+    }
+    staged.push(noiseFree.data());
+    fused.push(input.data(), noise.data(), fusedPower.data(), offset);
+
+    EXPECT_EQ(fusedPower, stagedPower);
+    for (int row = 0; row < GROUP_SIZE; ++row) {
+      for (int i = 0; i < size; ++i) {
+        EXPECT_FLOAT_EQ(fused.row(row)[i], staged.row(row)[i]);
+      }
+    }
+    for (int i = 0; i < size; ++i) {
+      EXPECT_NEAR(fused.average()[i], staged.average()[i], 1e-4f);
+    }
+  }
 }
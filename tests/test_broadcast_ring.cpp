@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <utils/broadcast_ring.h>
+
+#include <numeric>
+#include <thread>
+
+TEST(BroadcastRing, Readers) {
+  auto ring = std::make_shared<BroadcastRing<int>>(16);
+  EXPECT_FALSE(ring->hasReaders());
+  {
+    BroadcastRing<int>::Reader reader1(ring);
+    EXPECT_EQ(ring->readers(), 1);
+    BroadcastRing<int>::Reader reader2(ring);
+    EXPECT_EQ(ring->readers(), 2);
+  }
+  EXPECT_FALSE(ring->hasReaders());
+}
+
+TEST(BroadcastRing, Slices) {
+  auto ring = std::make_shared<BroadcastRing<int>>(16);
+  EXPECT_EQ(ring->writeSlice().size(), 4);
+
+  const std::vector<int> data = {0, 1, 2, 3, 4, 5};
+  ring->write(data.data(), 2);
+
+  // reader starts at current position, older items are not visible
+  BroadcastRing<int>::Reader reader1(ring);
+  ring->write(data.data() + 2, 4);
+  BroadcastRing<int>::Reader reader2(ring);
+  EXPECT_EQ(ring->written(), 6);
+  EXPECT_EQ(reader1.lag(), 4);
+  EXPECT_EQ(reader2.lag(), 0);
+
+  auto slice = reader1.readSlice();
+  EXPECT_EQ(std::vector<int>(slice.begin(), slice.end()), std::vector<int>({2, 3, 4, 5}));
+  EXPECT_TRUE(reader1.commitRead(3));
+  EXPECT_EQ(reader1.lag(), 1);
+  EXPECT_TRUE(reader2.readSlice().empty());
+
+  // every reader gets all items independently
+  ring->write(data.data(), 6);
+  slice = reader1.readSlice();
+  EXPECT_EQ(std::vector<int>(slice.begin(), slice.end()), std::vector<int>({5, 0, 1, 2, 3, 4, 5}));
+  EXPECT_TRUE(reader1.commitRead(slice.size()));
+  slice = reader2.readSlice();
+  EXPECT_EQ(std::vector<int>(slice.begin(), slice.end()), std::vector<int>({0, 1, 2, 3, 4, 5}));
+  EXPECT_TRUE(reader2.commitRead(slice.size()));
+  EXPECT_EQ(reader1.lost(), 0);
+  EXPECT_EQ(reader2.lost(), 0);
+}
+
+TEST(BroadcastRing, StartPosition) {
+  auto ring = std::make_shared<BroadcastRing<int>>(16);
+  std::vector<int> data(20);
+  std::iota(data.begin(), data.end(), 0);
+  ring->write(data.data(), 20);
+
+  // reader may start from older items, but not from items that may be overwritten soon or are not written yet
+  EXPECT_EQ(BroadcastRing<int>::Reader(ring, 16).position(), 16);
+  EXPECT_EQ(BroadcastRing<int>::Reader(ring, 2).position(), 14);
+  EXPECT_EQ(BroadcastRing<int>::Reader(ring, 30).position(), 20);
+  BroadcastRing<int>::Reader reader(ring, 16);
+  const auto slice = reader.readSlice();
+  EXPECT_EQ(std::vector<int>(slice.begin(), slice.end()), std::vector<int>({16, 17, 18, 19}));
+  EXPECT_TRUE(reader.commitRead(slice.size()));
+}
+
+TEST(BroadcastRing, Wrap) {
+  auto ring = std::make_shared<BroadcastRing<int>>(16);
+  BroadcastRing<int>::Reader reader(ring);
+  std::vector<int> data(10);
+  std::iota(data.begin(), data.end(), 0);
+  ring->write(data.data(), 10);
+  EXPECT_TRUE(reader.commitRead(reader.readSlice().size()));
+  std::iota(data.begin(), data.end(), 10);
+  ring->write(data.data(), 10);
+
+  // slice ends at the end of storage, rest is in next slice
+  auto slice = reader.readSlice();
+  EXPECT_EQ(std::vector<int>(slice.begin(), slice.end()), std::vector<int>({10, 11, 12, 13, 14, 15}));
+  EXPECT_TRUE(reader.commitRead(slice.size()));
+  slice = reader.readSlice();
+  EXPECT_EQ(std::vector<int>(slice.begin(), slice.end()), std::vector<int>({16, 17, 18, 19}));
+  EXPECT_TRUE(reader.commitRead(slice.size()));
+}
+
+TEST(BroadcastRing, Overrun) {
+  auto ring = std::make_shared<BroadcastRing<int>>(16);
+  BroadcastRing<int>::Reader slow(ring);
+  BroadcastRing<int>::Reader fast(ring);
+  std::vector<int> data(40);
+  std::iota(data.begin(), data.end(), 0);
+
+  // slow reader is overrun, it jumps forward and counts lost items, fast reader is not affected
+  for (int i = 0; i < 2; ++i) {
+    ring->write(data.data() + 10 * i, 10);
+    while (!fast.readSlice().empty()) {
+      EXPECT_TRUE(fast.commitRead(fast.readSlice().size()));
+    }
+  }
+  EXPECT_EQ(fast.lost(), 0);
+  EXPECT_EQ(fast.lag(), 0);
+  EXPECT_EQ(slow.lag(), 20);
+  auto slice = slow.readSlice();
+  EXPECT_EQ(slow.lost(), 14);
+  EXPECT_EQ(slice.front(), 14);
+  EXPECT_TRUE(slow.commitRead(slice.size()));
+  EXPECT_TRUE(slow.commitRead(slow.readSlice().size()));
+  EXPECT_EQ(slow.lag(), 0);
+
+  // slice taken before producer overwrote it is rejected
+  ring->write(data.data() + 20, 2);
+  slice = slow.readSlice();
+  EXPECT_EQ(slice.front(), 20);
+  ring->write(data.data() + 22, 18);
+  EXPECT_FALSE(slow.commitRead(slice.size()));
+  EXPECT_EQ(slow.lost(), 14 + 2 + 12);
+  slice = slow.readSlice();
+  EXPECT_EQ(slice.front(), 34);
+}
+
+TEST(BroadcastRing, Reservation) {
+  auto ring = std::make_shared<BroadcastRing<int>>(16);
+  BroadcastRing<int>::Reader reader(ring);
+  std::vector<int> data(16);
+  std::iota(data.begin(), data.end(), 0);
+
+  // items are valid until producer reserves their storage
+  ring->write(data.data(), 12);
+  auto slice = reader.readSlice();
+  ring->write(data.data() + 12, 4);
+  EXPECT_TRUE(reader.commitRead(slice.size()));
+
+  // slice is rejected as soon as producer reserves it, before items are committed
+  slice = reader.readSlice();
+  EXPECT_EQ(slice.front(), 12);
+  ring->write(data.data(), 12);
+  ring->writeSlice();
+  EXPECT_FALSE(reader.commitRead(slice.size()));
+  EXPECT_EQ(reader.lost(), 4);
+}
+
+TEST(BroadcastRing, Threads) {
+  constexpr auto COUNT = 1000000;
+  auto ring = std::make_shared<BroadcastRing<int>>(4096);
+  std::vector<std::unique_ptr<BroadcastRing<int>::Reader>> readers;
+  for (int i = 0; i < 3; ++i) {
+    readers.push_back(std::make_unique<BroadcastRing<int>::Reader>(ring));
+  }
+
+  std::thread producer([&ring]() {
+    int value = 0;
+    while (value < COUNT) {
+      auto slice = ring->writeSlice();
+      const auto size = std::min(static_cast<int>(slice.size()), COUNT - value);
+      std::iota(slice.begin(), slice.begin() + size, value);
+      ring->commitWrite(size);
+      value += size;
+    }
+  });
+
+  // items confirmed by commit are consecutive values, gaps are counted as lost
+  std::vector<std::thread> consumers;
+  for (auto& reader : readers) {
+    consumers.emplace_back([&reader]() {
+      uint64_t position = 0;
+      while (position + reader->lost() < COUNT) {
+        const auto slice = reader->readSlice();
+        if (slice.empty()) {
+          std::this_thread::yield();
+          continue;
+        }
+        const std::vector<int> copy(slice.begin(), slice.end());
+        const auto first = position + reader->lost();
+        if (reader->commitRead(copy.size())) {
+          for (size_t i = 0; i < copy.size(); ++i) {
+            EXPECT_EQ(static_cast<uint64_t>(copy[i]), first + i);
+          }
+          position += copy.size();
+        }
+      }
+    });
+  }
+  producer.join();
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+  for (const auto& reader : readers) {
+    EXPECT_EQ(reader->lag(), 0);
+  }
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include <radio/channel_map.h>
+
+TEST(ChannelMap, Count) {
+  EXPECT_EQ(ChannelMap(20000000, 200000, 32000).count(), 100);
+  EXPECT_EQ(ChannelMap(2048000, 200000, 32000).count(), 10);
+  EXPECT_EQ(ChannelMap(2400000, 200000, 32000).count(), 12);
+  EXPECT_EQ(ChannelMap(2600000, 200000, 32000).count(), 12);
+  EXPECT_EQ(ChannelMap(600000, 200000, 32000).count(), 0);
+  EXPECT_EQ(ChannelMap(2048000, 200000, 250000).count(), 0);
+}
+
+TEST(ChannelMap, Rate) {
+  EXPECT_DOUBLE_EQ(ChannelMap(2048000, 200000, 32000).spacing(), 204800.0);
+  EXPECT_EQ(ChannelMap(2048000, 200000, 32000).rate(), 409600);
+  EXPECT_EQ(ChannelMap(20000000, 200000, 32000).rate(), 400000);
+}
+
+TEST(ChannelMap, Channel) {
+  const ChannelMap map(20000000, 200000, 32000);
+  EXPECT_EQ(map.getChannel(0), 0);
+  EXPECT_EQ(map.getResidual(0), 0);
+  EXPECT_EQ(map.getChannel(99999), 0);
+  EXPECT_EQ(map.getResidual(99999), 99999);
+  EXPECT_EQ(map.getChannel(100001), 1);
+  EXPECT_EQ(map.getResidual(100001), -99999);
+  EXPECT_EQ(map.getChannel(1234567), 6);
+  EXPECT_EQ(map.getResidual(1234567), 34567);
+  EXPECT_EQ(map.getChannel(-150000), 99);
+  EXPECT_EQ(map.getResidual(-150000), 50000);
+  EXPECT_EQ(map.getChannel(-9950000), 50);
+  EXPECT_EQ(map.getResidual(-9950000), 50000);
+  EXPECT_EQ(map.getChannel(9950000), 50);
+  EXPECT_EQ(map.getResidual(9950000), -50000);
+}
+
+TEST(ChannelMap, FractionalSpacing) {
+  const ChannelMap map(2048000, 200000, 32000);
+  EXPECT_EQ(map.getChannel(-1000000), 5);
+  EXPECT_EQ(map.getResidual(-1000000), 24000);
+  EXPECT_EQ(map.getChannel(300000), 1);
+  EXPECT_EQ(map.getResidual(300000), 95200);
+}
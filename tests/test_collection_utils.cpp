@@ -45,6 +45,21 @@ TEST(CollectionUtils, ContaisWithMargin2) {
   EXPECT_FALSE(containsWithMargin(indexes, 16, 2));
 }
 
+TEST(CollectionUtils, ContaisWithMarginFlat) {
+  std::vector<std::pair<int, bool>> indexes({{10, false}, {14, false}});
+
+  EXPECT_FALSE(containsWithMargin(indexes, 8, 1));
+  EXPECT_TRUE(containsWithMargin(indexes, 9, 1));
+  EXPECT_TRUE(containsWithMargin(indexes, 10, 1));
+  EXPECT_TRUE(containsWithMargin(indexes, 11, 1));
+  EXPECT_FALSE(containsWithMargin(indexes, 12, 1));
+
+  EXPECT_TRUE(containsWithMargin(indexes, 13, 1));
+  EXPECT_TRUE(containsWithMargin(indexes, 14, 1));
+  EXPECT_TRUE(containsWithMargin(indexes, 15, 1));
+  EXPECT_FALSE(containsWithMargin(indexes, 16, 1));
+}
+
 TEST(CollectionUtils, mostFrequentValue) {
   std::vector<int> v1({1, 2, 3, 4, 5, 5});
   EXPECT_EQ(mostFrequentValue(v1), 5);
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <utils/dsp_utils.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+TEST(DspUtils, FastDb) {
+  for (float x = 1e-12f; x < 1e12f; x *= 1.0137f) {
+    EXPECT_NEAR(fastDb(x), 10.0f * std::log10(x), FAST_DB_MAX_ERROR) << "x: " << x;
+  }
+  EXPECT_NEAR(fastDb(1.0f), 0.0f, FAST_DB_MAX_ERROR);
+  EXPECT_NEAR(fastDb(2.0f), 3.0103f, FAST_DB_MAX_ERROR);
+  EXPECT_TRUE(std::isfinite(fastDb(0.0f)));
+}
+
+TEST(DspUtils, PowerToDb) {
+  constexpr auto SIZE = 4099;
+  constexpr auto SAMPLE_RATE = 2048000.0f;
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<float> amplitude(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> scale(-6.0f, 0.0f);
+
+  std::vector<std::complex<float>> input(SIZE);
+  for (auto& value : input) {
+    const auto s = std::pow(10.0f, scale(generator));
+    value = {s * amplitude(generator), s * amplitude(generator)};
+  }
+  std::vector<float> output(SIZE);
+  powerToDb(input.data(), output.data(), SIZE, -10.0f * std::log10(SAMPLE_RATE));
+
+  for (int i = 0; i < SIZE; ++i) {
+    if (input[i] != std::complex<float>(0.0f, 0.0f)) {
+      const auto expected = 10.0f * std::log10(std::pow(std::abs(input[i]), 2.0f) / SAMPLE_RATE);
+      EXPECT_NEAR(output[i], expected, 0.01f) << "index: " << i;
+    }
+  }
+}
+
+TEST(DspUtils, AveragePower) {
+  constexpr auto SIZE = 1027;
+  constexpr auto FRAMES = 8;
+  std::mt19937 generator(4321);
+  std::uniform_real_distribution<float> amplitude(-1.0f, 1.0f);
+
+  std::vector<float> sum(SIZE, 0.0f);
+  std::vector<double> expected(SIZE, 0.0);
+  for (int frame = 0; frame < FRAMES; ++frame) {
+    std::vector<std::complex<float>> input(SIZE);
+    for (int i = 0; i < SIZE; ++i) {
+      input[i] = {amplitude(generator), amplitude(generator)};
+      expected[i] += std::norm(input[i]);
+    }
+    addPower(input.data(), sum.data(), SIZE);
+  }
+  std::vector<float> output(SIZE);
+  linearToDb(sum.data(), output.data(), SIZE, -10.0f * std::log10(static_cast<float>(FRAMES)));
+
+  for (int i = 0; i < SIZE; ++i) {
+    EXPECT_NEAR(output[i], 10.0 * std::log10(expected[i] / FRAMES), 0.01f) << "index: " << i;
+  }
+}
+
+TEST(DspUtils, BoxFilter) {
+  std::vector<float> input({1, 2, 3, 4, 5, 6, 7, 8, 9});
+  std::vector<double> prefix(input.size() + 1);
+  std::vector<float> output(input.size(), 0.0);
+
+  boxFilter(input.data(), prefix.data(), output.data(), input.size(), 5, 1);
+  std::vector<float> result({2, 2.5, 3, 4, 5, 6, 7, 7.5, 8});
+  for (size_t i = 0; i < result.size(); ++i) {
+    EXPECT_FLOAT_EQ(output[i], result[i]);
+  }
+
+  boxFilter(input.data(), prefix.data(), output.data(), input.size(), 5, 2);
+  for (size_t i = 0; i < result.size(); ++i) {
+    EXPECT_FLOAT_EQ(output[i], result[i] / 2);
+  }
+
+  boxFilter(input.data(), prefix.data(), output.data(), 3, 21, 1);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_FLOAT_EQ(output[i], 2);
+  }
+}
+
+TEST(DspUtils, SelectIndexes) {
+  constexpr auto SIZE = 1000;
+  constexpr auto THRESHOLD = 8.0f;
+  std::mt19937 generator(2345);
+  std::uniform_real_distribution<float> power(-10.0f, 10.0f);
+  std::uniform_int_distribution<int> allowed(0, 9);
+
+  std::vector<float> data(SIZE);
+  std::vector<uint8_t> mask(SIZE);
+  std::vector<int> expected;
+  for (int i = 0; i < SIZE; ++i) {
+    // quiet blocks are mixed with busy ones
+    data[i] = (i / 64) % 3 == 0 ? power(generator) : -10.0f;
+    mask[i] = allowed(generator) != 0;
+    if (mask[i] && THRESHOLD <= data[i]) {
+      expected.push_back(i);
+    }
+  }
+
+  // indexes buffer has to fit size values for every call
+  std::vector<int> indexes(SIZE);
+  const auto count = selectIndexes(data.data(), mask.data(), THRESHOLD, SIZE, indexes.data());
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(std::vector<int>(indexes.begin(), indexes.begin() + count), expected);
+  EXPECT_EQ(selectIndexes(data.data(), mask.data(), 100.0f, SIZE, indexes.data()), 0);
+}
+
+TEST(DspUtils, Cfar) {
+  constexpr auto SIZE = 300;
+  constexpr auto GUARD = 3;
+  constexpr auto REFERENCE = 8;
+  std::mt19937 generator(3456);
+  std::uniform_real_distribution<float> power(-5.0f, 5.0f);
+
+  std::vector<float> input(SIZE);
+  for (auto& value : input) {
+    value = power(generator);
+  }
+  std::vector<double> prefix(SIZE + 1);
+  std::vector<float> output(SIZE);
+  cfar(input.data(), prefix.data(), output.data(), SIZE, GUARD, REFERENCE);
+
+  for (int i = 0; i < SIZE; ++i) {
+    const auto mean = [&](const int first, const int last) {
+      double sum = 0.0;
+      int count = 0;
+      for (int j = std::max(first, 0); j <= std::min(last, SIZE - 1); ++j) {
+        sum += input[j];
+        count++;
+      }
+      return count == 0 ? -std::numeric_limits<double>::max() : sum / count;
+    };
+    const auto left = mean(i - GUARD - REFERENCE, i - GUARD - 1);
+    const auto right = mean(i + GUARD + 1, i + GUARD + REFERENCE);
+    EXPECT_NEAR(output[i], input[i] - std::max(left, right), 1e-4) << "index: " << i;
+  }
+}
+
+TEST(DspUtils, CfarFloorChange) {
+  // step of noise floor is not detected also at its edges, narrow signal on top of it is
+  std::vector<float> input(200, 0.0f);
+  std::fill(input.begin() + 100, input.end(), 20.0f);
+  input[150] = 30.0f;
+  std::vector<double> prefix(input.size() + 1);
+  std::vector<float> output(input.size());
+  cfar(input.data(), prefix.data(), output.data(), input.size(), 2, 10);
+
+  for (int i = 0; i < static_cast<int>(input.size()); ++i) {
+    if (i != 150) {
+      EXPECT_LE(output[i], 1e-4f) << "index: " << i;
+    }
+  }
+  EXPECT_NEAR(output[50], 0.0f, 1e-4);
+  EXPECT_NEAR(output[100], 0.0f, 1e-4);
+  EXPECT_NEAR(output[150], 10.0f, 1e-4);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <radio/mode_estimator.h>
+#include <utils/collection_utils.h>
+
+#include <random>
+#include <vector>
+
+ModeEstimator generateEstimator(const int center, const int radius, const std::vector<int>& values) {
+  ModeEstimator estimator(center, radius);
+  for (const auto value : values) {
+    estimator.add(value);
+  }
+  return estimator;
+}
+
+TEST(ModeEstimator, SameAsMostFrequentValue) {
+  for (const auto& values : std::vector<std::vector<int>>({{1, 2, 3, 4, 5, 5}, {3, 3, 1, 1, 5, 5}, {3, 3, 1, 1, 5, 5, 2, 2}, {1, 1, 1, 1, 2, 5, 5, 5}, {4}})) {
+    EXPECT_EQ(generateEstimator(3, 3, values).mode(), mostFrequentValue(values));
+  }
+}
+
+TEST(ModeEstimator, Random) {
+  std::mt19937 generator(1234);
+  std::normal_distribution<float> distribution(0.0f, 3.0f);
+  for (int i = 0; i < 100; ++i) {
+    const auto center = 1000 + i;
+    ModeEstimator estimator(center, 10);
+    std::vector<int> values;
+    for (int j = 0; j < 1 + 10 * i; ++j) {
+      const auto value = center + std::clamp(static_cast<int>(distribution(generator)), -10, 10);
+      values.push_back(value);
+      estimator.add(value);
+    }
+    EXPECT_EQ(estimator.mode(), mostFrequentValue(values));
+  }
+}
+
+TEST(ModeEstimator, Bounds) {
+  ModeEstimator estimator(100, 2);
+  EXPECT_TRUE(estimator.empty());
+  EXPECT_EQ(estimator.mode(), 100);
+
+  estimator.add(97);
+  estimator.add(103);
+  EXPECT_TRUE(estimator.empty());
+  EXPECT_EQ(estimator.mode(), 100);
+
+  estimator.add(98);
+  estimator.add(102);
+  estimator.add(102);
+  EXPECT_EQ(estimator.mode(), 102);
+
+  estimator.reset(50);
+  EXPECT_TRUE(estimator.empty());
+  estimator.add(49);
+  EXPECT_EQ(estimator.mode(), 49);
+}
@@ -15,6 +15,37 @@ TEST(RadioUtils, Fft) {
   EXPECT_EQ(getFft(104857600 + 1, 100), 2097152);
 }
 
+TEST(RadioUtils, WisdomFileName) {
+  EXPECT_EQ(getWisdomFileName(".", "Intel(R) Core(TM) i7-8700 CPU @ 3.20GHz", 12), "./fftw_wisdom_intel_r_core_tm_i7_8700_cpu_3_20ghz_12.dat");
+  EXPECT_EQ(getWisdomFileName("/tmp", "Cortex-A72", 4), "/tmp/fftw_wisdom_cortex_a72_4.dat");
+  EXPECT_EQ(getWisdomFileName("/tmp", " ", 1), "/tmp/fftw_wisdom_unknown_1.dat");
+}
+
+TEST(RadioUtils, FftThreads) {
+  EXPECT_EQ(getFftThreads(8192, 8), 1);
+  EXPECT_EQ(getFftThreads(65536, 8), 1);
+  EXPECT_EQ(getFftThreads(131072, 8), 2);
+  EXPECT_EQ(getFftThreads(1048576, 8), 4);
+  EXPECT_EQ(getFftThreads(1048576, 4), 2);
+  EXPECT_EQ(getFftThreads(1048576, 1), 1);
+  EXPECT_EQ(getFftThreads(1048576, 0), 1);
+}
+
+TEST(RadioUtils, FftBatch) {
+  EXPECT_EQ(getFftBatch(2048), 16);
+  EXPECT_EQ(getFftBatch(8192), 8);
+  EXPECT_EQ(getFftBatch(65536), 1);
+  EXPECT_EQ(getFftBatch(1048576), 1);
+}
+
+TEST(RadioUtils, ScaleBins) {
+  EXPECT_EQ(scaleBins(21, 1), 21);
+  EXPECT_EQ(scaleBins(21, 16), 1);
+  EXPECT_EQ(scaleBins(40, 16), 3);
+  EXPECT_EQ(scaleBins(1, 16), 1);
+  EXPECT_EQ(scaleBins(0, 16), 0);
+}
+
 TEST(RadioUtils, PrimeFactors) {
   EXPECT_EQ(getPrimeFactors(1), std::vector<int>({1}));
   EXPECT_EQ(getPrimeFactors(2), std::vector<int>({2}));
@@ -130,3 +161,13 @@ TEST(RadioUtils, SplitRanges) {
   EXPECT_EQ(splitRange({140000000, 145000000}, 2000000), Ranges({{140000000, 142000000}, {142000000, 144000000}, {144000000, 146000000}}));
   EXPECT_EQ(splitRange({140000000, 150000000}, 2000000), Ranges({{140000000, 142000000}, {142000000, 144000000}, {144000000, 146000000}, {146000000, 148000000}, {148000000, 150000000}}));
 }
+
+TEST(RadioUtils, AllowedIndexes) {
+  using Mask = std::vector<uint8_t>;
+  const auto indexToFrequency = [](const int index) { return static_cast<Frequency>(100 + 10 * index); };
+  EXPECT_EQ(getAllowedIndexes({100, 190}, {}, 10, indexToFrequency), Mask({1, 1, 1, 1, 1, 1, 1, 1, 1, 1}));
+  EXPECT_EQ(getAllowedIndexes({115, 165}, {}, 10, indexToFrequency), Mask({0, 0, 1, 1, 1, 1, 1, 0, 0, 0}));
+  EXPECT_EQ(getAllowedIndexes({100, 190}, {{120, 130}}, 10, indexToFrequency), Mask({1, 1, 0, 0, 1, 1, 1, 1, 1, 1}));
+  EXPECT_EQ(getAllowedIndexes({100, 190}, {{121, 129}, {175, 250}}, 10, indexToFrequency), Mask({1, 1, 1, 1, 1, 1, 1, 1, 0, 0}));
+  EXPECT_EQ(getAllowedIndexes({100, 190}, {{0, 100}, {140, 140}, {150, 150}}, 10, indexToFrequency), Mask({0, 1, 1, 1, 0, 0, 1, 1, 1, 1}));
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <utils/ring_buffer.h>
+
+#include <numeric>
+#include <thread>
+
+TEST(RingBuffer, Slices) {
+  RingBuffer<int> buffer(8);
+  EXPECT_EQ(buffer.capacity(), 8);
+  EXPECT_EQ(buffer.size(), 0);
+  EXPECT_TRUE(buffer.readSlice().empty());
+
+  auto write = buffer.writeSlice();
+  EXPECT_EQ(write.size(), 8);
+  std::iota(write.begin(), write.begin() + 6, 0);
+  buffer.commitWrite(6);
+  EXPECT_EQ(buffer.size(), 6);
+  EXPECT_EQ(buffer.writeSlice().size(), 2);
+
+  auto read = buffer.readSlice();
+  EXPECT_EQ(read.size(), 6);
+  EXPECT_EQ(read[0], 0);
+  EXPECT_EQ(read[5], 5);
+  buffer.commitRead(4);
+  EXPECT_EQ(buffer.size(), 2);
+
+  // free space wraps around, first slice ends at the end of storage
+  write = buffer.writeSlice();
+  EXPECT_EQ(write.size(), 2);
+  write[0] = 6;
+  write[1] = 7;
+  buffer.commitWrite(2);
+  write = buffer.writeSlice();
+  EXPECT_EQ(write.size(), 4);
+  write[0] = 8;
+  buffer.commitWrite(1);
+  EXPECT_EQ(buffer.size(), 5);
+  EXPECT_EQ(buffer.writeSlice().size(), 3);
+
+  read = buffer.readSlice();
+  EXPECT_EQ(read.size(), 4);
+  EXPECT_EQ(read[0], 4);
+  EXPECT_EQ(read[3], 7);
+  buffer.commitRead(4);
+  read = buffer.readSlice();
+  EXPECT_EQ(read.size(), 1);
+  EXPECT_EQ(read[0], 8);
+  buffer.commitRead(1);
+  EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST(RingBuffer, Full) {
+  RingBuffer<int> buffer(4);
+  buffer.commitWrite(buffer.writeSlice().size());
+  EXPECT_EQ(buffer.size(), 4);
+  EXPECT_TRUE(buffer.writeSlice().empty());
+
+  buffer.addOverflow(10);
+  buffer.addOverflow(5);
+  EXPECT_EQ(buffer.overflows(), 15);
+}
+
+TEST(RingBuffer, Threads) {
+  constexpr uint64_t COUNT = 1000000;
+  RingBuffer<uint64_t> buffer(1000);
+
+  std::thread producer([&buffer]() {
+    uint64_t value = 0;
+    while (value < COUNT) {
+      auto slice = buffer.writeSlice();
+      if (slice.empty()) {
+        std::this_thread::yield();
+      }
+      const auto count = std::min<uint64_t>(slice.size(), COUNT - value);
+      for (uint64_t i = 0; i < count; ++i) {
+        slice[i] = value++;
+      }
+      buffer.commitWrite(count);
+    }
+  });
+
+  uint64_t expected = 0;
+  bool isValid = true;
+  while (expected < COUNT) {
+    const auto slice = buffer.readSlice();
+    if (slice.empty()) {
+      std::this_thread::yield();
+    }
+    for (const auto value : slice) {
+      isValid &= value == expected++;
+    }
+    buffer.commitRead(slice.size());
+  }
+  producer.join();
+
+  EXPECT_TRUE(isValid);
+  EXPECT_EQ(buffer.size(), 0);
+  EXPECT_EQ(buffer.overflows(), 0);
+}
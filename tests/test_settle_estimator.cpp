@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <radio/settle_estimator.h>
+
+constexpr auto BLOCK_SIZE = 100;
+constexpr auto BLOCKS = 20;
+
+std::vector<float> generatePowers(const int transient, const float transientPower) {
+  std::vector<float> powers(BLOCKS, -50.0f);
+  for (int i = 0; i < transient; ++i) {
+    powers[i] = transientPower;
+  }
+  return powers;
+}
+
+TEST(SettleEstimator, FindSettleBlock) {
+  EXPECT_EQ(SettleEstimator::findSettleBlock({}), 0);
+  EXPECT_EQ(SettleEstimator::findSettleBlock(generatePowers(0, 0.0f)), 0);
+  EXPECT_EQ(SettleEstimator::findSettleBlock(generatePowers(3, -80.0f)), 3);
+  EXPECT_EQ(SettleEstimator::findSettleBlock(generatePowers(5, -20.0f)), 5);
+  EXPECT_EQ(SettleEstimator::findSettleBlock(generatePowers(5, -51.0f)), 0);
+}
+
+TEST(SettleEstimator, IgnoreSecondHalf) {
+  auto powers = generatePowers(2, -80.0f);
+  powers[BLOCKS - 3] = -10.0f;
+  EXPECT_EQ(SettleEstimator::findSettleBlock(powers), 2);
+
+  powers = generatePowers(BLOCKS, -80.0f);
+  EXPECT_EQ(SettleEstimator::findSettleBlock(powers), 0);
+}
+
+TEST(SettleEstimator, Median) {
+  SettleEstimator estimator(BLOCK_SIZE, BLOCKS, 1000);
+  EXPECT_EQ(estimator.getSettleSamples(), 1000);
+
+  estimator.addMeasurement(generatePowers(2, -80.0f));
+  EXPECT_EQ(estimator.getSettleSamples(), 2 * BLOCK_SIZE);
+  estimator.addMeasurement(generatePowers(8, -80.0f));
+  estimator.addMeasurement(generatePowers(3, -80.0f));
+  EXPECT_EQ(estimator.getSettleSamples(), 3 * BLOCK_SIZE);
+  estimator.addMeasurement(generatePowers(9, -80.0f));
+  estimator.addMeasurement(generatePowers(9, -80.0f));
+  EXPECT_EQ(estimator.getSettleSamples(), 8 * BLOCK_SIZE);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <utils/shared_ring.h>
+
+#include <string>
+#include <vector>
+
+std::string getRingName() { return "/sdr_scanner_test_" + std::to_string(getpid()); }
+
+std::vector<std::complex<float>> getSamples(const int first, const int count) {
+  std::vector<std::complex<float>> samples;
+  for (int i = first; i < first + count; ++i) {
+    samples.emplace_back(static_cast<float>(i), static_cast<float>(-i));
+  }
+  return samples;
+}
+
+TEST(SharedRing, Header) {
+  SharedRingWriter writer(getRingName(), 16, 2048000);
+  SharedRingReader reader(getRingName());
+  EXPECT_EQ(reader.header().magic, SharedRingHeader::MAGIC);
+  EXPECT_EQ(reader.header().sampleSize, sizeof(std::complex<float>));
+  EXPECT_EQ(reader.header().capacity, 16);
+  EXPECT_EQ(reader.header().maxWrite, 4);
+  EXPECT_EQ(reader.header().sampleRate, 2048000);
+  EXPECT_EQ(reader.written(), 0);
+  EXPECT_EQ(reader.retune().sequence, 0);
+
+  writer.setRetune(100000000, 0);
+  writer.setRetune(102000000, 12345);
+  const auto retune = reader.retune();
+  EXPECT_EQ(retune.sequence, 2);
+  EXPECT_EQ(retune.centerFrequency, 102000000);
+  EXPECT_EQ(retune.cursor, 12345);
+}
+
+TEST(SharedRing, Read) {
+  SharedRingWriter writer(getRingName(), 16, 2048000);
+  SharedRingReader reader(getRingName());
+  std::vector<std::complex<float>> data(10);
+
+  // samples not written yet are not available
+  writer.write(getSamples(0, 10).data(), 10);
+  EXPECT_EQ(reader.written(), 10);
+  EXPECT_FALSE(reader.read(5, data.data(), 10));
+  EXPECT_TRUE(reader.read(0, data.data(), 10));
+  EXPECT_EQ(data, getSamples(0, 10));
+
+  // samples wrapped around end of ring are copied in order
+  writer.write(getSamples(10, 10).data(), 10);
+  EXPECT_TRUE(reader.read(10, data.data(), 10));
+  EXPECT_EQ(data, getSamples(10, 10));
+
+  // samples are available until write reserves their storage
+  EXPECT_TRUE(reader.read(4, data.data(), 4));
+  EXPECT_FALSE(reader.read(3, data.data(), 4));
+  EXPECT_EQ(reader.header().reserveCursor, reader.written());
+}
+
+TEST(SharedRing, Unlink) {
+  {
+    SharedRingWriter writer(getRingName(), 16, 2048000);
+  }
+  EXPECT_THROW(SharedRingReader reader(getRingName()), std::runtime_error);
+}
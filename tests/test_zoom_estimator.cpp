@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <radio/zoom_estimator.h>
+
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+constexpr auto SAMPLE_RATE = 2048000;
+constexpr auto FRAME_SIZE = 8192;
+constexpr auto COARSE_SIZE = 512;
+constexpr auto DECIMATION = COARSE_SIZE / 4;
+
+std::vector<std::complex<float>> generateFrame(const std::vector<std::pair<double, float>>& tones) {
+  std::mt19937 generator(1234);
+  std::normal_distribution<float> noise(0.0f, 0.1f);
+  std::vector<std::complex<float>> frame(FRAME_SIZE);
+  for (int i = 0; i < FRAME_SIZE; ++i) {
+    frame[i] = {noise(generator), noise(generator)};
+    for (const auto& [frequency, amplitude] : tones) {
+      frame[i] += std::polar(amplitude, static_cast<float>(std::fmod(2.0 * std::numbers::pi * frequency * i / SAMPLE_RATE, 2.0 * std::numbers::pi)));
+    }
+  }
+  return frame;
+}
+
+TEST(ZoomEstimator, SingleTone) {
+  constexpr auto FINE_STEP = SAMPLE_RATE / FRAME_SIZE;
+  constexpr auto COARSE_STEP = SAMPLE_RATE / COARSE_SIZE;
+  ZoomEstimator estimator(FRAME_SIZE, DECIMATION, SAMPLE_RATE);
+  EXPECT_EQ(estimator.getBins(), 64);
+
+  for (const auto frequency : {12345.0, -250000.0, 503210.0, -3.0}) {
+    const auto frame = generateFrame({{frequency, 1.0f}});
+    // coarse bin center closest to tone
+    const auto coarseShift = static_cast<Frequency>(std::round(frequency / COARSE_STEP) * COARSE_STEP);
+    const auto result = estimator.estimate(frame.data(), coarseShift, COARSE_STEP);
+    EXPECT_LE(std::abs(result - frequency), FINE_STEP) << "frequency: " << frequency;
+  }
+}
+
+TEST(ZoomEstimator, StrongerToneInSpan) {
+  constexpr auto COARSE_STEP = SAMPLE_RATE / COARSE_SIZE;
+  ZoomEstimator estimator(FRAME_SIZE, DECIMATION, SAMPLE_RATE);
+  const auto frame = generateFrame({{100000.0, 0.2f}, {101500.0, 1.0f}, {120000.0, 5.0f}});
+  const auto result = estimator.estimate(frame.data(), 100000, COARSE_STEP);
+  EXPECT_LE(std::abs(result - 101500), SAMPLE_RATE / FRAME_SIZE);
+}
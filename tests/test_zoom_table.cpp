@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include <radio/zoom_table.h>
+
+TEST(ZoomTable, Shifts) {
+  ZoomTable table(2);
+  std::vector<ZoomTable::Index> indexes;
+
+  table.setIndexes(0, {5, 7});
+  table.getIndexes(0, indexes);
+  EXPECT_EQ(indexes, std::vector<ZoomTable::Index>({5, 7}));
+  table.getIndexes(1, indexes);
+  EXPECT_TRUE(indexes.empty());
+
+  table.setShifts(0, {{5, 1000}, {7, 2000}});
+  EXPECT_EQ(table.getShift(0, 5), 1000);
+  EXPECT_EQ(table.getShift(0, 7), 2000);
+  EXPECT_EQ(table.getShift(1, 5), std::nullopt);
+
+  // consumed shift is removed with its request, new signal at the same index waits for fresh shift
+  table.setIndexes(0, {7});
+  EXPECT_EQ(table.getShift(0, 5), std::nullopt);
+  EXPECT_EQ(table.getShift(0, 7), 2000);
+  table.setIndexes(0, {});
+  table.setIndexes(0, {5});
+  EXPECT_EQ(table.getShift(0, 5), std::nullopt);
+
+  // shifts computed for withdrawn requests are dropped
+  table.setShifts(0, {{5, 1500}, {7, 2500}});
+  EXPECT_EQ(table.getShift(0, 5), 1500);
+  EXPECT_EQ(table.getShift(0, 7), std::nullopt);
+}